@@ -143,6 +143,78 @@ void incflo::fillpatch_gradp (int lev, Real time, MultiFab& gp, int ng)
     }
 }
 
+void incflo::fillpatch_mac_phi (int lev, Real time, MultiFab& mac_phi, int ng)
+{
+    if (lev == 0) {
+        PhysBCFunct<GpuBndryFuncFab<IncfloForFill> > physbc
+            (geom[lev], get_force_bcrec(), IncfloForFill{m_probtype});
+        FillPatchSingleLevel(mac_phi, IntVect(ng), time,
+                             {&(m_leveldata[lev]->mac_phi)}, {time},
+                             0, 0, 1, geom[lev], physbc, 0);
+    } else {
+        const auto& bcrec = get_force_bcrec();
+        PhysBCFunct<GpuBndryFuncFab<IncfloForFill> > cphysbc
+            (geom[lev-1], bcrec, IncfloForFill{m_probtype});
+        PhysBCFunct<GpuBndryFuncFab<IncfloForFill> > fphysbc
+            (geom[lev], bcrec, IncfloForFill{m_probtype});
+#ifdef AMREX_USE_EB
+        Interpolater* mapper = (EBFactory(0).isAllRegular()) ?
+            (Interpolater*)(&cell_cons_interp) : (Interpolater*)(&eb_cell_cons_interp);
+#else
+        Interpolater* mapper = &cell_cons_interp;
+#endif
+        FillPatchTwoLevels(mac_phi, IntVect(ng), time,
+                           {&(m_leveldata[lev-1]->mac_phi)}, {time},
+                           {&(m_leveldata[lev]->mac_phi)}, {time},
+                           0, 0, 1, geom[lev-1], geom[lev],
+                           cphysbc, 0, fphysbc, 0,
+                           refRatio(lev-1), mapper, bcrec, 0);
+    }
+}
+
+void incflo::fillpatch_p_cc (int lev, Real time, MultiFab& p_cc, int ng)
+{
+    if (lev == 0) {
+        PhysBCFunct<GpuBndryFuncFab<IncfloForFill> > physbc
+            (geom[lev], get_force_bcrec(), IncfloForFill{m_probtype});
+        FillPatchSingleLevel(p_cc, IntVect(ng), time,
+                             {&(m_leveldata[lev]->p_cc)}, {time},
+                             0, 0, 1, geom[lev], physbc, 0);
+    } else {
+        const auto& bcrec = get_force_bcrec();
+        PhysBCFunct<GpuBndryFuncFab<IncfloForFill> > cphysbc
+            (geom[lev-1], bcrec, IncfloForFill{m_probtype});
+        PhysBCFunct<GpuBndryFuncFab<IncfloForFill> > fphysbc
+            (geom[lev], bcrec, IncfloForFill{m_probtype});
+#ifdef AMREX_USE_EB
+        Interpolater* mapper = (EBFactory(0).isAllRegular()) ?
+            (Interpolater*)(&cell_cons_interp) : (Interpolater*)(&eb_cell_cons_interp);
+#else
+        Interpolater* mapper = &cell_cons_interp;
+#endif
+        FillPatchTwoLevels(p_cc, IntVect(ng), time,
+                           {&(m_leveldata[lev-1]->p_cc)}, {time},
+                           {&(m_leveldata[lev]->p_cc)}, {time},
+                           0, 0, 1, geom[lev-1], geom[lev],
+                           cphysbc, 0, fphysbc, 0,
+                           refRatio(lev-1), mapper, bcrec, 0);
+    }
+}
+
+// The nodal pressure is only used as an initial guess and for output, so we
+// fill it directly: bilinear interpolation from the coarse level, then the
+// old data on this level wherever it exists. This avoids the (cell-centered)
+// EB machinery in FillPatchTwoLevels.
+void incflo::fillpatch_p_nd (int lev, MultiFab& p_nd)
+{
+    if (lev > 0) {
+        fillcoarsepatch_p_nd(lev, p_nd);
+    } else {
+        p_nd.setVal(0.0);
+    }
+    p_nd.ParallelCopy(m_leveldata[lev]->p_nd, 0, 0, 1, 0, 0, geom[lev].periodicity());
+}
+
 void incflo::fillpatch_force (Real time, Vector<MultiFab*> const& force, int ng)
 {
     const int ncomp = force[0]->nComp();
@@ -253,3 +325,93 @@ void incflo::fillcoarsepatch_gradp (int lev, Real time, MultiFab& gp, int ng)
                                  cphysbc, 0, fphysbc, 0,
                                  refRatio(lev-1), mapper, bcrec, 0);
 }
+
+void incflo::fillcoarsepatch_mac_phi (int lev, Real time, MultiFab& mac_phi, int ng)
+{
+    const auto& bcrec = get_force_bcrec();
+    PhysBCFunct<GpuBndryFuncFab<IncfloForFill> > cphysbc
+        (geom[lev-1], bcrec, IncfloForFill{m_probtype});
+    PhysBCFunct<GpuBndryFuncFab<IncfloForFill> > fphysbc
+        (geom[lev], bcrec, IncfloForFill{m_probtype});
+#ifdef AMREX_USE_EB
+    Interpolater* mapper = (EBFactory(0).isAllRegular()) ?
+        (Interpolater*)(&cell_cons_interp) : (Interpolater*)(&eb_cell_cons_interp);
+#else
+    Interpolater* mapper = &cell_cons_interp;
+#endif
+    amrex::InterpFromCoarseLevel(mac_phi, IntVect(ng), time,
+                                 m_leveldata[lev-1]->mac_phi, 0, 0, 1,
+                                 geom[lev-1], geom[lev],
+                                 cphysbc, 0, fphysbc, 0,
+                                 refRatio(lev-1), mapper, bcrec, 0);
+}
+
+void incflo::fillcoarsepatch_p_cc (int lev, Real time, MultiFab& p_cc, int ng)
+{
+    const auto& bcrec = get_force_bcrec();
+    PhysBCFunct<GpuBndryFuncFab<IncfloForFill> > cphysbc
+        (geom[lev-1], bcrec, IncfloForFill{m_probtype});
+    PhysBCFunct<GpuBndryFuncFab<IncfloForFill> > fphysbc
+        (geom[lev], bcrec, IncfloForFill{m_probtype});
+#ifdef AMREX_USE_EB
+    Interpolater* mapper = (EBFactory(0).isAllRegular()) ?
+        (Interpolater*)(&cell_cons_interp) : (Interpolater*)(&eb_cell_cons_interp);
+#else
+    Interpolater* mapper = &cell_cons_interp;
+#endif
+    amrex::InterpFromCoarseLevel(p_cc, IntVect(ng), time,
+                                 m_leveldata[lev-1]->p_cc, 0, 0, 1,
+                                 geom[lev-1], geom[lev],
+                                 cphysbc, 0, fphysbc, 0,
+                                 refRatio(lev-1), mapper, bcrec, 0);
+}
+
+void incflo::fillcoarsepatch_p_nd (int lev, MultiFab& p_nd)
+{
+    const IntVect rr = refRatio(lev-1);
+
+    // Proper nesting guarantees that the coarsened nodal boxes are covered
+    // by the coarse level
+    BoxArray cba = p_nd.boxArray();
+    cba.coarsen(rr);
+    MultiFab p_crse(cba, p_nd.DistributionMap(), 1, 0);
+    p_crse.ParallelCopy(m_leveldata[lev-1]->p_nd, 0, 0, 1, 0, 0, geom[lev-1].periodicity());
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(p_nd,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        Box const& nbx = mfi.tilebox();
+        Array4<Real> const& pf = p_nd.array(mfi);
+        Array4<Real const> const& pc = p_crse.const_array(mfi);
+        amrex::ParallelFor(nbx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            const int ic = amrex::coarsen(i, rr[0]);
+            const int jc = amrex::coarsen(j, rr[1]);
+            const Real wx = Real(i - ic*rr[0]) / Real(rr[0]);
+            const Real wy = Real(j - jc*rr[1]) / Real(rr[1]);
+            // Do not touch the next coarse node when we sit on a coarse node
+            const int icp = (wx > 0.0) ? ic+1 : ic;
+            const int jcp = (wy > 0.0) ? jc+1 : jc;
+#if (AMREX_SPACEDIM == 2)
+            pf(i,j,k) = (1.0-wx)*(1.0-wy)*pc(ic ,jc ,0)
+                      +      wx *(1.0-wy)*pc(icp,jc ,0)
+                      + (1.0-wx)*     wy *pc(ic ,jcp,0)
+                      +      wx *     wy *pc(icp,jcp,0);
+#else
+            const int kc = amrex::coarsen(k, rr[2]);
+            const Real wz = Real(k - kc*rr[2]) / Real(rr[2]);
+            const int kcp = (wz > 0.0) ? kc+1 : kc;
+            pf(i,j,k) = (1.0-wz) * ( (1.0-wx)*(1.0-wy)*pc(ic ,jc ,kc )
+                                   +      wx *(1.0-wy)*pc(icp,jc ,kc )
+                                   + (1.0-wx)*     wy *pc(ic ,jcp,kc )
+                                   +      wx *     wy *pc(icp,jcp,kc ) )
+                      +      wz  * ( (1.0-wx)*(1.0-wy)*pc(ic ,jc ,kcp)
+                                   +      wx *(1.0-wy)*pc(icp,jc ,kcp)
+                                   + (1.0-wx)*     wy *pc(ic ,jcp,kcp)
+                                   +      wx *     wy *pc(icp,jcp,kcp) );
+#endif
+        });
+    }
+}
@@ -134,18 +134,33 @@ incflo::compute_MAC_projected_velocities (
     //
     // Perform MAC projection
     //
-    if (m_use_mac_phi_in_godunov)
+    if (m_use_mac_phi_in_godunov || m_mac_warm_start)
     {
-        // The MAC projection always starts with phi == 0, but we might like
-        //     to change that so we reduce the cost of the MAC projection
+        // With warm start we reuse mac_phi from the previous MAC solve (the
+        //     predictor's when we are in the corrector).  When mac_phi holds the
+        //     full pressure it is stored as twice the solution and does not
+        //     depend on dt. Otherwise we assume the velocity correction
+        //     (dt/rho) grad(phi) carries over, so phi scales with 1/dt.
+        bool warm_start = m_mac_warm_start && (m_mac_phi_dt > 0.0);
         for (int lev=0; lev <= finest_level; ++lev)
-            mac_phi[lev]->setVal(0.);
-            //mac_phi[lev]->mult(0.5,0,1,1);
+        {
+            if (!warm_start) {
+                mac_phi[lev]->setVal(0.);
+            } else if (m_use_mac_phi_in_godunov) {
+                mac_phi[lev]->mult(0.5,0,1,1);
+            } else {
+                mac_phi[lev]->mult(m_mac_phi_dt/l_dt,0,1,1);
+            }
+        }
 
         macproj->project(mac_phi,m_mac_mg_rtol,m_mac_mg_atol);
+        m_mac_phi_dt = l_dt;
 
-        for (int lev=0; lev <= finest_level; ++lev)
-            mac_phi[lev]->mult(2.0,0,1,1);
+        if (m_use_mac_phi_in_godunov)
+        {
+            for (int lev=0; lev <= finest_level; ++lev)
+                mac_phi[lev]->mult(2.0,0,1,1);
+        }
     } else {
         macproj->project(m_mac_mg_rtol,m_mac_mg_atol);
     }
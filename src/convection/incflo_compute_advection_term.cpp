@@ -84,48 +84,30 @@ incflo::compute_convective_term (Vector<MultiFab*> const& conv_u,
     if (!m_constant_density) n_flux_comp += 1;
     if ( m_advect_tracer)    n_flux_comp += m_ntrac;
 
-    // This will hold state on faces
-    Vector<MultiFab> face_x(finest_level+1);
-    Vector<MultiFab> face_y(finest_level+1);
-#if (AMREX_SPACEDIM == 3)
-    Vector<MultiFab> face_z(finest_level+1);
-#endif
-
-    // This will hold fluxes on faces
-    Vector<MultiFab> flux_x(finest_level+1);
-    Vector<MultiFab> flux_y(finest_level+1);
-#if (AMREX_SPACEDIM == 3)
-    Vector<MultiFab> flux_z(finest_level+1);
-#endif
-
-    Vector<MultiFab> divu(finest_level+1);
-    Vector<MultiFab> rhotrac(finest_level+1);
+    // Face states and fluxes hold all the components (velocity, density, tracers);
+    //    they, the divergence and (rho*trac) come from the persistent workspace
+    AMREX_D_TERM(Vector<MultiFab*> face_x = get_workspace(&Workspace::face_x);,
+                 Vector<MultiFab*> face_y = get_workspace(&Workspace::face_y);,
+                 Vector<MultiFab*> face_z = get_workspace(&Workspace::face_z););
+    AMREX_D_TERM(Vector<MultiFab*> flux_x = get_workspace(&Workspace::flux_x);,
+                 Vector<MultiFab*> flux_y = get_workspace(&Workspace::flux_y);,
+                 Vector<MultiFab*> flux_z = get_workspace(&Workspace::flux_z););
+    AMREX_ASSERT(face_x[0]->nComp() == n_flux_comp);
+
+    Vector<MultiFab*> divu = get_workspace(&Workspace::divu);
+    Vector<MultiFab*> rhotrac = get_workspace(&Workspace::rhotrac);
 
     Vector<Array<MultiFab*,AMREX_SPACEDIM> > fluxes(finest_level+1);
     Vector<Array<MultiFab*,AMREX_SPACEDIM> >  faces(finest_level+1);
 
     for (int lev = 0; lev <= finest_level; ++lev) {
-        AMREX_D_TERM(
-           face_x[lev].define(u_mac[lev]->boxArray(),dmap[lev],n_flux_comp,0,MFInfo(),Factory(lev));,
-           face_y[lev].define(v_mac[lev]->boxArray(),dmap[lev],n_flux_comp,0,MFInfo(),Factory(lev));,
-           face_z[lev].define(w_mac[lev]->boxArray(),dmap[lev],n_flux_comp,0,MFInfo(),Factory(lev)););
-        AMREX_D_TERM(
-           flux_x[lev].define(u_mac[lev]->boxArray(),dmap[lev],n_flux_comp,0,MFInfo(),Factory(lev));,
-           flux_y[lev].define(v_mac[lev]->boxArray(),dmap[lev],n_flux_comp,0,MFInfo(),Factory(lev));,
-           flux_z[lev].define(w_mac[lev]->boxArray(),dmap[lev],n_flux_comp,0,MFInfo(),Factory(lev)););
-
-        divu[lev].define(vel[lev]->boxArray(),dmap[lev],1,4,MFInfo(),Factory(lev));
-        if (m_advect_tracer && m_ntrac > 0)
-            rhotrac[lev].define(vel[lev]->boxArray(),dmap[lev],tracer[lev]->nComp(),
-                                tracer[lev]->nGrow(),MFInfo(),Factory(lev));
-
-        AMREX_D_TERM(faces[lev][0] = &face_x[lev];,
-                     faces[lev][1] = &face_y[lev];,
-                     faces[lev][2] = &face_z[lev];);
+        AMREX_D_TERM(faces[lev][0] = face_x[lev];,
+                     faces[lev][1] = face_y[lev];,
+                     faces[lev][2] = face_z[lev];);
 
-        AMREX_D_TERM(fluxes[lev][0] = &flux_x[lev];,
-                     fluxes[lev][1] = &flux_y[lev];,
-                     fluxes[lev][2] = &flux_z[lev];);
+        AMREX_D_TERM(fluxes[lev][0] = flux_x[lev];,
+                     fluxes[lev][1] = flux_y[lev];,
+                     fluxes[lev][2] = flux_z[lev];);
     }
 
     // We now re-compute the velocity forcing terms including the pressure gradient,
@@ -204,7 +186,7 @@ incflo::compute_convective_term (Vector<MultiFab*> const& conv_u,
                          w_mac[lev]->FillBoundary(geom[lev].periodicity()););
         }
 
-        divu[lev].setVal(0.);
+        divu[lev]->setVal(0.);
         Array<MultiFab const*, AMREX_SPACEDIM> u;
         AMREX_D_TERM(u[0] = u_mac[lev];,
                      u[1] = v_mac[lev];,
@@ -215,18 +197,18 @@ incflo::compute_convective_term (Vector<MultiFab*> const& conv_u,
 
         if (!ebfact.isAllRegular()) {
             if (m_eb_flow.enabled) {
-               amrex::EB_computeDivergence(divu[lev],u,geom[lev],true,*get_velocity_eb()[lev]);
+               amrex::EB_computeDivergence(*divu[lev],u,geom[lev],true,*get_velocity_eb()[lev]);
             } else {
-               amrex::EB_computeDivergence(divu[lev],u,geom[lev],true);
+               amrex::EB_computeDivergence(*divu[lev],u,geom[lev],true);
             }
         }
         else
 #endif
         {
-            amrex::computeDivergence(divu[lev],u,geom[lev]);
+            amrex::computeDivergence(*divu[lev],u,geom[lev]);
         }
 
-        divu[lev].FillBoundary(geom[lev].periodicity());
+        divu[lev]->FillBoundary(geom[lev].periodicity());
 
         // ************************************************************************
         // Define (rho*trac)
@@ -236,9 +218,11 @@ incflo::compute_convective_term (Vector<MultiFab*> const& conv_u,
 #endif
         for (MFIter mfi(*density[lev],TilingIfNotGPU()); mfi.isValid(); ++mfi)
         {
+            Real strt_cost = ParallelDescriptor::second();
+
             Box const& bx = mfi.tilebox();
 
-            Array4<Real const> const& divu_arr = divu[lev].const_array(mfi);
+            Array4<Real const> const& divu_arr = divu[lev]->const_array(mfi);
 
             // ************************************************************************
             // Velocity
@@ -248,12 +232,12 @@ incflo::compute_convective_term (Vector<MultiFab*> const& conv_u,
             bool is_velocity = true;
             HydroUtils::ComputeFluxesOnBoxFromState( bx, ncomp, mfi,
                                                   vel[lev]->const_array(mfi),
-                                     AMREX_D_DECL(flux_x[lev].array(mfi,face_comp),
-                                                  flux_y[lev].array(mfi,face_comp),
-                                                  flux_z[lev].array(mfi,face_comp)),
-                                     AMREX_D_DECL(face_x[lev].array(mfi,face_comp),
-                                                  face_y[lev].array(mfi,face_comp),
-                                                  face_z[lev].array(mfi,face_comp)),
+                                     AMREX_D_DECL(flux_x[lev]->array(mfi,face_comp),
+                                                  flux_y[lev]->array(mfi,face_comp),
+                                                  flux_z[lev]->array(mfi,face_comp)),
+                                     AMREX_D_DECL(face_x[lev]->array(mfi,face_comp),
+                                                  face_y[lev]->array(mfi,face_comp),
+                                                  face_z[lev]->array(mfi,face_comp)),
                                      knownFaceStates,
                                      AMREX_D_DECL(u_mac[lev]->const_array(mfi),
                                                   v_mac[lev]->const_array(mfi),
@@ -283,12 +267,12 @@ incflo::compute_convective_term (Vector<MultiFab*> const& conv_u,
                 is_velocity = false;
                 HydroUtils::ComputeFluxesOnBoxFromState( bx, ncomp, mfi,
                                                        density[lev]->const_array(mfi),
-                                          AMREX_D_DECL(flux_x[lev].array(mfi,face_comp),
-                                                       flux_y[lev].array(mfi,face_comp),
-                                                       flux_z[lev].array(mfi,face_comp)),
-                                          AMREX_D_DECL(face_x[lev].array(mfi,face_comp),
-                                                       face_y[lev].array(mfi,face_comp),
-                                                       face_z[lev].array(mfi,face_comp)),
+                                          AMREX_D_DECL(flux_x[lev]->array(mfi,face_comp),
+                                                       flux_y[lev]->array(mfi,face_comp),
+                                                       flux_z[lev]->array(mfi,face_comp)),
+                                          AMREX_D_DECL(face_x[lev]->array(mfi,face_comp),
+                                                       face_y[lev]->array(mfi,face_comp),
+                                                       face_z[lev]->array(mfi,face_comp)),
                                           knownFaceStates,
                                           AMREX_D_DECL(u_mac[lev]->const_array(mfi),
                                                        v_mac[lev]->const_array(mfi),
@@ -320,7 +304,7 @@ incflo::compute_convective_term (Vector<MultiFab*> const& conv_u,
 
                 Array4<Real const> tra     =  tracer[lev]->const_array(mfi);
                 Array4<Real const> rho     = density[lev]->const_array(mfi);
-                Array4<Real      > ro_trac = rhotrac[lev].array(mfi);
+                Array4<Real      > ro_trac = rhotrac[lev]->array(mfi);
 
                 amrex::ParallelFor(bxg, m_ntrac,
                 [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
@@ -336,12 +320,12 @@ incflo::compute_convective_term (Vector<MultiFab*> const& conv_u,
                 is_velocity = false;
 
                 HydroUtils::ComputeFluxesOnBoxFromState( bx, ncomp, mfi, ro_trac,
-                                          AMREX_D_DECL(flux_x[lev].array(mfi,face_comp),
-                                                       flux_y[lev].array(mfi,face_comp),
-                                                       flux_z[lev].array(mfi,face_comp)),
-                                          AMREX_D_DECL(face_x[lev].array(mfi,face_comp),
-                                                       face_y[lev].array(mfi,face_comp),
-                                                       face_z[lev].array(mfi,face_comp)),
+                                          AMREX_D_DECL(flux_x[lev]->array(mfi,face_comp),
+                                                       flux_y[lev]->array(mfi,face_comp),
+                                                       flux_z[lev]->array(mfi,face_comp)),
+                                          AMREX_D_DECL(face_x[lev]->array(mfi,face_comp),
+                                                       face_y[lev]->array(mfi,face_comp),
+                                                       face_z[lev]->array(mfi,face_comp)),
                                           knownFaceStates,
                                           AMREX_D_DECL(u_mac[lev]->const_array(mfi),
                                                        v_mac[lev]->const_array(mfi),
@@ -360,6 +344,8 @@ incflo::compute_convective_term (Vector<MultiFab*> const& conv_u,
                                           is_velocity, fluxes_are_area_weighted,
                                           m_advection_type);
             }
+
+            if (collect_costs()) add_cost(lev, mfi, strt_cost);
         } // mfi
     } // lev
 
@@ -381,9 +367,9 @@ incflo::compute_convective_term (Vector<MultiFab*> const& conv_u,
     for (int lev = 0; lev <= finest_level; ++lev)
     {
 #ifdef AMREX_USE_EB
-        MultiFab dvdt_tmp(vel[lev]->boxArray(),dmap[lev],AMREX_SPACEDIM,3,MFInfo(),Factory(lev));
-        MultiFab drdt_tmp(vel[lev]->boxArray(),dmap[lev],1             ,3,MFInfo(),Factory(lev));
-        MultiFab dtdt_tmp(vel[lev]->boxArray(),dmap[lev],m_ntrac       ,3,MFInfo(),Factory(lev));
+        MultiFab& dvdt_tmp = get_workspace(lev).dvdt_tmp;
+        MultiFab& drdt_tmp = get_workspace(lev).drdt_tmp;
+        MultiFab& dtdt_tmp = get_workspace(lev).dtdt_tmp;
 
         // Must initialize to zero because not all values may be set, e.g. outside the domain.
         dvdt_tmp.setVal(0.);
@@ -401,6 +387,8 @@ incflo::compute_convective_term (Vector<MultiFab*> const& conv_u,
 #endif
         for (MFIter mfi(*conv_u[lev],TilingIfNotGPU()); mfi.isValid(); ++mfi)
         {
+            Real strt_cost = ParallelDescriptor::second();
+
             Box const& bx = mfi.tilebox();
 
             int flux_comp = 0;
@@ -410,9 +398,9 @@ incflo::compute_convective_term (Vector<MultiFab*> const& conv_u,
             auto const& update_arr  = dvdt_tmp.array(mfi);
             if (flagfab.getType(bx) != FabType::covered)
                 HydroUtils::EB_ComputeDivergence(bx, update_arr,
-                                                 AMREX_D_DECL(flux_x[lev].const_array(mfi,flux_comp),
-                                                              flux_y[lev].const_array(mfi,flux_comp),
-                                                              flux_z[lev].const_array(mfi,flux_comp)),
+                                                 AMREX_D_DECL(flux_x[lev]->const_array(mfi,flux_comp),
+                                                              flux_y[lev]->const_array(mfi,flux_comp),
+                                                              flux_z[lev]->const_array(mfi,flux_comp)),
                                                  vfrac.const_array(mfi), num_comp, geom[lev],
                                                  mult, fluxes_are_area_weighted,
                                                  m_eb_flow.enabled ? 
@@ -427,19 +415,19 @@ incflo::compute_convective_term (Vector<MultiFab*> const& conv_u,
 #else
             auto const& update_arr  = conv_u[lev]->array(mfi);
             HydroUtils::ComputeDivergence(bx, update_arr,
-                                          AMREX_D_DECL(flux_x[lev].const_array(mfi,flux_comp),
-                                                       flux_y[lev].const_array(mfi,flux_comp),
-                                                       flux_z[lev].const_array(mfi,flux_comp)),
+                                          AMREX_D_DECL(flux_x[lev]->const_array(mfi,flux_comp),
+                                                       flux_y[lev]->const_array(mfi,flux_comp),
+                                                       flux_z[lev]->const_array(mfi,flux_comp)),
                                           num_comp, geom[lev],
                                           mult, fluxes_are_area_weighted);
 #endif
 
             // If convective, we define u dot grad u = div (u u) - u div(u)
             auto const& q           =  vel[lev]->array(mfi,0);
-            auto const& divu_arr    = divu[lev].array(mfi);
-            AMREX_D_TERM(auto const& q_on_face_x  = face_x[lev].const_array(mfi);,
-                         auto const& q_on_face_y  = face_y[lev].const_array(mfi);,
-                         auto const& q_on_face_z  = face_z[lev].const_array(mfi););
+            auto const& divu_arr    = divu[lev]->array(mfi);
+            AMREX_D_TERM(auto const& q_on_face_x  = face_x[lev]->const_array(mfi);,
+                         auto const& q_on_face_y  = face_y[lev]->const_array(mfi);,
+                         auto const& q_on_face_z  = face_z[lev]->const_array(mfi););
 
             int const* iconserv_ptr = get_velocity_iconserv_device_ptr();
             if (m_advection_type == "MOL")
@@ -511,6 +499,8 @@ incflo::compute_convective_term (Vector<MultiFab*> const& conv_u,
                 }
 #endif
             } // Godunov
+
+            if (collect_costs()) add_cost(lev, mfi, strt_cost);
         } // mfi
 
         // Note: density is always updated conservatively -- we do not provide an option for
@@ -526,9 +516,9 @@ incflo::compute_convective_term (Vector<MultiFab*> const& conv_u,
             EBCellFlagFab const& flagfab = ebfact->getMultiEBCellFlagFab()[mfi];
             if (flagfab.getType(bx) != FabType::covered)
                 HydroUtils::EB_ComputeDivergence(bx, drdt_tmp.array(mfi),
-                                                 AMREX_D_DECL(flux_x[lev].const_array(mfi,flux_comp),
-                                                              flux_y[lev].const_array(mfi,flux_comp),
-                                                              flux_z[lev].const_array(mfi,flux_comp)),
+                                                 AMREX_D_DECL(flux_x[lev]->const_array(mfi,flux_comp),
+                                                              flux_y[lev]->const_array(mfi,flux_comp),
+                                                              flux_z[lev]->const_array(mfi,flux_comp)),
                                                  vfrac.const_array(mfi), 1, geom[lev], mult,
                                                  fluxes_are_area_weighted,
                                                  m_eb_flow.enabled ? 
@@ -542,9 +532,9 @@ incflo::compute_convective_term (Vector<MultiFab*> const& conv_u,
                                                     ebfact->getBndryNormal().const_array(mfi) : Array4<Real const>{});
 #else
             HydroUtils::ComputeDivergence(bx, conv_r[lev]->array(mfi),
-                                          AMREX_D_DECL(flux_x[lev].const_array(mfi,flux_comp),
-                                                       flux_y[lev].const_array(mfi,flux_comp),
-                                                       flux_z[lev].const_array(mfi,flux_comp)),
+                                          AMREX_D_DECL(flux_x[lev]->const_array(mfi,flux_comp),
+                                                       flux_y[lev]->const_array(mfi,flux_comp),
+                                                       flux_z[lev]->const_array(mfi,flux_comp)),
                                           1, geom[lev], mult,
                                           fluxes_are_area_weighted);
 #endif
@@ -566,9 +556,9 @@ incflo::compute_convective_term (Vector<MultiFab*> const& conv_u,
             auto const& update_arr  = dtdt_tmp.array(mfi);
             if (flagfab.getType(bx) != FabType::covered)
                 HydroUtils::EB_ComputeDivergence(bx, update_arr,
-                                                 AMREX_D_DECL(flux_x[lev].const_array(mfi,flux_comp),
-                                                              flux_y[lev].const_array(mfi,flux_comp),
-                                                              flux_z[lev].const_array(mfi,flux_comp)),
+                                                 AMREX_D_DECL(flux_x[lev]->const_array(mfi,flux_comp),
+                                                              flux_y[lev]->const_array(mfi,flux_comp),
+                                                              flux_z[lev]->const_array(mfi,flux_comp)),
                                                  vfrac.const_array(mfi), m_ntrac, geom[lev], mult,
                                                  fluxes_are_area_weighted,
                                                  m_eb_flow.enabled ? 
@@ -583,9 +573,9 @@ incflo::compute_convective_term (Vector<MultiFab*> const& conv_u,
 #else
                 auto const& update_arr  = conv_t[lev]->array(mfi);
                 HydroUtils::ComputeDivergence(bx, update_arr,
-                                              AMREX_D_DECL(flux_x[lev].const_array(mfi,flux_comp),
-                                                           flux_y[lev].const_array(mfi,flux_comp),
-                                                           flux_z[lev].const_array(mfi,flux_comp)),
+                                              AMREX_D_DECL(flux_x[lev]->const_array(mfi,flux_comp),
+                                                           flux_y[lev]->const_array(mfi,flux_comp),
+                                                           flux_z[lev]->const_array(mfi,flux_comp)),
                                               m_ntrac, geom[lev], mult,
                                               fluxes_are_area_weighted);
 #endif
@@ -602,11 +592,13 @@ incflo::compute_convective_term (Vector<MultiFab*> const& conv_u,
 
         for (MFIter mfi(*density[lev],TilingIfNotGPU()); mfi.isValid(); ++mfi)
         {
+            Real strt_cost = ParallelDescriptor::second();
+
             Box const& bx = mfi.tilebox();
             redistribute_convective_term (bx, mfi,
                                           vel[lev]->const_array(mfi),
                                           density[lev]->const_array(mfi),
-                                          (m_advect_tracer && (m_ntrac>0)) ? rhotrac[lev].const_array(mfi) : Array4<Real const>{},
+                                          (m_advect_tracer && (m_ntrac>0)) ? rhotrac[lev]->const_array(mfi) : Array4<Real const>{},
                                           dvdt_tmp.array(mfi),
                                           drdt_tmp.array(mfi),
                                           (m_advect_tracer && (m_ntrac>0)) ? dtdt_tmp.array(mfi) : Array4<Real>{},
@@ -615,6 +607,8 @@ incflo::compute_convective_term (Vector<MultiFab*> const& conv_u,
                                           (m_advect_tracer && (m_ntrac>0)) ? conv_t[lev]->array(mfi) : Array4<Real>{},
                                           m_redistribution_type, m_constant_density, m_advect_tracer, m_ntrac,
                                           ebfact, geom[lev], m_dt);
+
+            if (collect_costs()) add_cost(lev, mfi, strt_cost);
        } // mfi
 #endif
     } // lev
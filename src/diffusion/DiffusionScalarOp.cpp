@@ -13,10 +13,16 @@ DiffusionScalarOp::DiffusionScalarOp (incflo* a_incflo)
 {
     readParameters();
 
+    m_grids = m_incflo->boxArray(0,m_incflo->finestLevel());
+    m_dmap  = m_incflo->DistributionMap(0,m_incflo->finestLevel());
+
     LPInfo info_solve;
     info_solve.setMaxCoarseningLevel(m_mg_max_coarsening_level);
     LPInfo info_apply;
     info_apply.setMaxCoarseningLevel(0);
+
+    // Number of components in the velocity solve operator
+    const int nvel = m_fused_vel_solve ? AMREX_SPACEDIM : 1;
 #ifdef AMREX_USE_EB
     int finest_level = m_incflo->finestLevel();
     if (!m_incflo->EBFactory(0).isAllRegular())
@@ -39,10 +45,14 @@ DiffusionScalarOp::DiffusionScalarOp (incflo* a_incflo)
             m_eb_vel_solve_op.reset(new MLEBABecLap(m_incflo->Geom(0,finest_level),
                                                     m_incflo->boxArray(0,finest_level),
                                                     m_incflo->DistributionMap(0,finest_level),
-                                                    info_solve, ebfact));
+                                                    info_solve, ebfact, nvel));
             m_eb_vel_solve_op->setMaxOrder(m_mg_maxorder);
 
-            // We don't call setDomainBC here because we will need to call it separately for each component
+            // When solving the components one at a time we call setDomainBC separately for each component
+            if (m_fused_vel_solve) {
+                m_eb_vel_solve_op->setDomainBC(get_diffuse_velocity_bc_vec(Orientation::low),
+                                               get_diffuse_velocity_bc_vec(Orientation::high));
+            }
         }
 
         if (m_incflo->need_divtau())
@@ -56,7 +66,8 @@ DiffusionScalarOp::DiffusionScalarOp (incflo* a_incflo)
                                             m_incflo->get_diffuse_scalar_bc(Orientation::high));
         }
 
-        if ( (m_incflo->need_divtau() && !m_incflo->useTensorSolve()) ||
+        if ( ((m_incflo->need_divtau() || m_incflo->useNewtonViscosity()) &&
+              !m_incflo->useTensorSolve()) ||
               m_incflo->useTensorCorrection() )
         {
             m_eb_vel_apply_op.reset(new MLEBABecLap(m_incflo->Geom(0,finest_level),
@@ -84,10 +95,14 @@ DiffusionScalarOp::DiffusionScalarOp (incflo* a_incflo)
             m_reg_vel_solve_op.reset(new MLABecLaplacian(m_incflo->Geom(0,m_incflo->finestLevel()),
                                                          m_incflo->boxArray(0,m_incflo->finestLevel()),
                                                          m_incflo->DistributionMap(0,m_incflo->finestLevel()),
-                                                         info_solve));
+                                                         info_solve, {}, nvel));
             m_reg_vel_solve_op->setMaxOrder(m_mg_maxorder);
 
-            // We don't call setDomainBC here because we will need to call it separately for each component
+            // When solving the components one at a time we call setDomainBC separately for each component
+            if (m_fused_vel_solve) {
+                m_reg_vel_solve_op->setDomainBC(get_diffuse_velocity_bc_vec(Orientation::low),
+                                                get_diffuse_velocity_bc_vec(Orientation::high));
+            }
         }
         if (m_incflo->need_divtau()) {
             m_reg_scal_apply_op.reset(new MLABecLaplacian(m_incflo->Geom(0,m_incflo->finestLevel()),
@@ -99,7 +114,8 @@ DiffusionScalarOp::DiffusionScalarOp (incflo* a_incflo)
                                              m_incflo->get_diffuse_scalar_bc(Orientation::high));
         }
 
-        if ( (m_incflo->need_divtau() && !m_incflo->useTensorSolve()) ||
+        if ( ((m_incflo->need_divtau() || m_incflo->useNewtonViscosity()) &&
+              !m_incflo->useTensorSolve()) ||
               m_incflo->useTensorCorrection() )
         {
             m_reg_vel_apply_op.reset(new MLABecLaplacian(m_incflo->Geom(0,m_incflo->finestLevel()),
@@ -133,6 +149,35 @@ DiffusionScalarOp::readParameters ()
 
     pp.query("num_pre_smooth", m_num_pre_smooth);
     pp.query("num_post_smooth", m_num_post_smooth);
+
+    pp.query("batch_tracers", m_batch_tracers);
+    pp.query("fused_velocity_solve", m_fused_vel_solve);
+    pp.query("warm_start", m_warm_start);
+}
+
+Vector<Array<LinOpBCType,AMREX_SPACEDIM>>
+DiffusionScalarOp::get_diffuse_velocity_bc_vec (Orientation::Side side) const
+{
+    Vector<Array<LinOpBCType,AMREX_SPACEDIM>> r;
+    for (int comp = 0; comp < AMREX_SPACEDIM; ++comp) {
+        r.push_back(m_incflo->get_diffuse_velocity_bc(side, comp));
+    }
+    return r;
+}
+
+bool
+DiffusionScalarOp::needsRebuild () const
+{
+    const int finest_level = m_incflo->finestLevel();
+    if (static_cast<int>(m_grids.size()) != finest_level+1) return true;
+
+    for (int lev = 0; lev <= finest_level; ++lev) {
+        if (m_grids[lev] != m_incflo->boxArray(lev) ||
+            m_dmap[lev]  != m_incflo->DistributionMap(lev)) {
+            return true;
+        }
+    }
+    return false;
 }
 
 void
@@ -151,12 +196,42 @@ DiffusionScalarOp::diffuse_scalar (Vector<MultiFab*> const& tracer,
     //      a: rho
     //      b: mu
 
+    m_scal_stats.clear();
+
+    const int finest_level = m_incflo->finestLevel();
+
+    // Tracers with zero diffusivity are left alone: with b = 0 the solve would
+    // just give back rho*s/rho = s.
+    // With constant diffusivities the regular operators take m_mu_s directly.
+    const bool constant_coeff = m_incflo->useConstantTracerDiffusion();
+
+    Vector<int> comps;
+    for (int comp = 0; comp < tracer[0]->nComp(); ++comp)
+    {
+        Real eta_max = 0.0;
+        if (m_incflo->m_tracer_diff_model == incflo::TracerDiffusivityModel::constant) {
+            eta_max = m_incflo->m_mu_s[comp];
+        } else {
+            for (int lev = 0; lev <= finest_level; ++lev) {
+                eta_max = amrex::max(eta_max, eta[lev]->norm0(comp,0,true));
+            }
+            ParallelDescriptor::ReduceRealMax(eta_max);
+        }
+        if (eta_max > 0.0) comps.push_back(comp);
+    }
+
+    if (comps.empty()) return;
+
+    if (m_batch_tracers && comps.size() > 1)
+    {
+        diffuse_scalar_batched(tracer, density, eta, comps, dt);
+        return;
+    }
+
     if (m_verbose > 0) {
         amrex::Print() << "Diffusing scalars one at a time ..." << std::endl;
     }
 
-    const int finest_level = m_incflo->finestLevel();
-
     Vector<MultiFab> rhs(finest_level+1);
     for (int lev = 0; lev <= finest_level; ++lev) {
         rhs[lev].define(tracer[lev]->boxArray(), tracer[lev]->DistributionMap(), 1, 0);
@@ -175,17 +250,21 @@ DiffusionScalarOp::diffuse_scalar (Vector<MultiFab*> const& tracer,
     {
         m_reg_scal_solve_op->setScalars(1.0, dt);
         for (int lev = 0; lev <= finest_level; ++lev) {
-            m_reg_scal_solve_op->setACoeffs(lev, *density[lev]);
+            if (constant_coeff && m_incflo->m_constant_density) {
+                m_reg_scal_solve_op->setACoeffs(lev, m_incflo->m_ro_0);
+            } else {
+                m_reg_scal_solve_op->setACoeffs(lev, *density[lev]);
+            }
         }
     }
 
-    for (int comp = 0; comp < tracer[0]->nComp(); ++comp)
+    for (int comp : comps)
     {
 #ifdef AMREX_USE_EB
         if (m_eb_scal_solve_op)
         {
             for (int lev = 0; lev <= finest_level; ++lev) {
-                Array<MultiFab,AMREX_SPACEDIM> b = m_incflo->average_scalar_eta_to_faces(lev, comp, *eta[lev]);
+                auto const& b = m_incflo->get_eta_faces(lev, comp, *eta[lev]);
                 m_eb_scal_solve_op->setBCoeffs(lev, GetArrOfConstPtrs(b), MLMG::Location::FaceCentroid);
             }
         }
@@ -193,8 +272,12 @@ DiffusionScalarOp::diffuse_scalar (Vector<MultiFab*> const& tracer,
 #endif
         {
             for (int lev = 0; lev <= finest_level; ++lev) {
-                Array<MultiFab,AMREX_SPACEDIM> b = m_incflo->average_scalar_eta_to_faces(lev, comp, *eta[lev]);
-                m_reg_scal_solve_op->setBCoeffs(lev, GetArrOfConstPtrs(b));
+                if (constant_coeff) {
+                    m_reg_scal_solve_op->setBCoeffs(lev, m_incflo->m_mu_s[comp]);
+                } else {
+                    auto const& b = m_incflo->get_eta_faces(lev, comp, *eta[lev]);
+                    m_reg_scal_solve_op->setBCoeffs(lev, GetArrOfConstPtrs(b));
+                }
             }
         }
 
@@ -234,32 +317,229 @@ DiffusionScalarOp::diffuse_scalar (Vector<MultiFab*> const& tracer,
 #else
         MLMG mlmg(*m_reg_scal_solve_op);
 #endif
+        setMLMGOptions(mlmg);
+
+        solve(mlmg, phi, rhs, density, m_scal_corr, tracer[0]->nComp(), {comp}, dt, m_scal_stats);
+    }
+}
+
+void
+DiffusionScalarOp::diffuse_scalar_batched (Vector<MultiFab*> const& tracer,
+                                           Vector<MultiFab*> const& density,
+                                           Vector<MultiFab const*> const& eta,
+                                           Vector<int> const& comps,
+                                           Real dt)
+{
+    // All tracers share the same domain and EB boundary condition types, so they can
+    // go through a single multi-component solve with per-component b coefficients.
+    const int finest_level = m_incflo->finestLevel();
+    const int nbatch = static_cast<int>(comps.size());
 
-        // The default bottom solver is BiCG
-        if (m_mg_bottom_solver == "smoother")
+    if (m_verbose > 0) {
+        amrex::Print() << "Diffusing " << nbatch << " scalars together ..." << std::endl;
+    }
+
+    // The operator's component count is fixed at construction, so rebuild it if
+    // the number of diffusing tracers has changed
+    if (m_batch_ncomp != nbatch)
+    {
+        LPInfo info_solve;
+        info_solve.setMaxCoarseningLevel(m_mg_max_coarsening_level);
+
+        Vector<Array<LinOpBCType,AMREX_SPACEDIM>> lobc(nbatch, m_incflo->get_diffuse_scalar_bc(Orientation::low));
+        Vector<Array<LinOpBCType,AMREX_SPACEDIM>> hibc(nbatch, m_incflo->get_diffuse_scalar_bc(Orientation::high));
+
+#ifdef AMREX_USE_EB
+        if (m_eb_scal_solve_op)
+        {
+            Vector<EBFArrayBoxFactory const*> ebfact;
+            for (int lev = 0; lev <= finest_level; ++lev) {
+                ebfact.push_back(&(m_incflo->EBFactory(lev)));
+            }
+            m_eb_scal_batch_op.reset(new MLEBABecLap(m_incflo->Geom(0,finest_level),
+                                                     m_incflo->boxArray(0,finest_level),
+                                                     m_incflo->DistributionMap(0,finest_level),
+                                                     info_solve, ebfact, nbatch));
+            m_eb_scal_batch_op->setMaxOrder(m_mg_maxorder);
+            m_eb_scal_batch_op->setDomainBC(lobc, hibc);
+        }
+        else
+#endif
+        {
+            m_reg_scal_batch_op.reset(new MLABecLaplacian(m_incflo->Geom(0,finest_level),
+                                                          m_incflo->boxArray(0,finest_level),
+                                                          m_incflo->DistributionMap(0,finest_level),
+                                                          info_solve, {}, nbatch));
+            m_reg_scal_batch_op->setMaxOrder(m_mg_maxorder);
+            m_reg_scal_batch_op->setDomainBC(lobc, hibc);
+        }
+        m_batch_ncomp = nbatch;
+    }
+
+#ifdef AMREX_USE_EB
+    MLLinOp& linop = m_eb_scal_batch_op ? static_cast<MLLinOp&>(*m_eb_scal_batch_op)
+                                        : static_cast<MLLinOp&>(*m_reg_scal_batch_op);
+#else
+    MLLinOp& linop = *m_reg_scal_batch_op;
+#endif
+
+#ifdef AMREX_USE_EB
+    if (m_eb_scal_batch_op) {
+        m_eb_scal_batch_op->setScalars(1.0, dt);
+    } else
+#endif
+    {
+        m_reg_scal_batch_op->setScalars(1.0, dt);
+    }
+
+    Vector<MultiFab> phi(finest_level+1);
+    Vector<MultiFab> rhs(finest_level+1);
+
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        const auto& ba = tracer[lev]->boxArray();
+        const auto& dm = tracer[lev]->DistributionMap();
+        const auto& fact = tracer[lev]->Factory();
+
+        // Pack the b coefficients of the diffusing tracers
+        Array<MultiFab,AMREX_SPACEDIM> b{AMREX_D_DECL(MultiFab(amrex::convert(ba,IntVect::TheDimensionVector(0)),
+                                                  dm, nbatch, 0, MFInfo(), fact),
+                                         MultiFab(amrex::convert(ba,IntVect::TheDimensionVector(1)),
+                                                  dm, nbatch, 0, MFInfo(), fact),
+                                         MultiFab(amrex::convert(ba,IntVect::TheDimensionVector(2)),
+                                                  dm, nbatch, 0, MFInfo(), fact))};
+        for (int n = 0; n < nbatch; ++n) {
+            auto const& bn = m_incflo->get_eta_faces(lev, comps[n], *eta[lev]);
+            for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+                MultiFab::Copy(b[dir], bn[dir], 0, n, 1, 0);
+            }
+        }
+
+        // Pack the tracers, including the ghost cells holding the boundary values
+        phi[lev].define(ba, dm, nbatch, 1, MFInfo(), fact);
+        rhs[lev].define(ba, dm, nbatch, 0);
+        for (int n = 0; n < nbatch; ++n) {
+            MultiFab::Copy(phi[lev], *tracer[lev], comps[n], n, 1, 1);
+        }
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(rhs[lev],TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+            Box const& bx = mfi.tilebox();
+            Array4<Real> const& rhs_a = rhs[lev].array(mfi);
+            Array4<Real const> const& tra_a = phi[lev].const_array(mfi);
+            Array4<Real const> const& rho_a = density[lev]->const_array(mfi);
+            amrex::ParallelFor(bx, nbatch,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+            {
+                rhs_a(i,j,k,n) = rho_a(i,j,k) * tra_a(i,j,k,n);
+            });
+        }
+
+#ifdef AMREX_USE_EB
+        if (m_eb_scal_batch_op)
         {
-            mlmg.setBottomSolver(MLMG::BottomSolver::smoother);
+            m_eb_scal_batch_op->setACoeffs(lev, *density[lev]);
+            m_eb_scal_batch_op->setBCoeffs(lev, GetArrOfConstPtrs(b), MLMG::Location::FaceCentroid);
+            m_eb_scal_batch_op->setLevelBC(lev, &phi[lev]);
         }
-        else if (m_mg_bottom_solver == "hypre")
+        else
+#endif
         {
-            mlmg.setBottomSolver(MLMG::BottomSolver::hypre);
+            m_reg_scal_batch_op->setACoeffs(lev, *density[lev]);
+            m_reg_scal_batch_op->setBCoeffs(lev, GetArrOfConstPtrs(b));
+            m_reg_scal_batch_op->setLevelBC(lev, &phi[lev]);
         }
-        // Maximum iterations for MultiGrid / ConjugateGradients
-        mlmg.setMaxIter(m_mg_max_iter);
-        mlmg.setMaxFmgIter(m_mg_max_fmg_iter);
-        mlmg.setBottomMaxIter(m_mg_bottom_maxiter);
+    }
 
-        // Verbosity for MultiGrid / ConjugateGradients
-        mlmg.setVerbose(m_mg_verbose);
-        mlmg.setBottomVerbose(m_mg_bottom_verbose);
+    MLMG mlmg(linop);
+    setMLMGOptions(mlmg);
 
-        mlmg.setPreSmooth(m_num_pre_smooth);
-        mlmg.setPostSmooth(m_num_post_smooth);
+    solve(mlmg, phi, rhs, density, m_scal_corr, tracer[0]->nComp(), comps, dt, m_scal_stats);
 
-        mlmg.solve(GetVecOfPtrs(phi), GetVecOfConstPtrs(rhs), m_mg_rtol, m_mg_atol);
+    for (int lev = 0; lev <= finest_level; ++lev) {
+        for (int n = 0; n < nbatch; ++n) {
+            MultiFab::Copy(*tracer[lev], phi[lev], n, comps[n], 1, 0);
+        }
     }
 }
 
+void
+DiffusionScalarOp::solve (MLMG& mlmg, Vector<MultiFab>& phi, Vector<MultiFab> const& rhs,
+                          Vector<MultiFab*> const& density, Correction& corr, int ncorr,
+                          Vector<int> const& comps, Real dt, Vector<DiffusionSolveStats>& stats)
+{
+    const int finest_level = m_incflo->finestLevel();
+    const int ncomp = static_cast<int>(comps.size());
+
+    // Start from the explicit update plus the previous correction, rescaled for dt
+    bool warm_start = false;
+    if (m_warm_start && !corr.corr.empty())
+    {
+        for (int n = 0; n < ncomp; ++n) {
+            Real corr_dt = corr.dt[comps[n]];
+            if (corr_dt > 0.0) {
+                warm_start = true;
+                for (int lev = 0; lev <= finest_level; ++lev) {
+                    MultiFab::Saxpy(phi[lev], dt/corr_dt, corr.corr[lev], comps[n], n, 1, 0);
+                }
+            }
+        }
+    }
+
+    mlmg.solve(GetVecOfPtrs(phi), GetVecOfConstPtrs(rhs), m_mg_rtol, m_mg_atol);
+
+    stats.emplace_back(mlmg, warm_start);
+    if (m_verbose > 0) {
+        amrex::Print() << "  Diffusion solve: " << stats.back().num_iters << " MLMG iterations"
+                       << (warm_start ? " (warm start)" : "") << std::endl;
+    }
+
+    if (m_warm_start)
+    {
+        if (corr.corr.empty()) {
+            corr.corr.resize(finest_level+1);
+            corr.dt.assign(ncorr, 0.0);
+            for (int lev = 0; lev <= finest_level; ++lev) {
+                corr.corr[lev].define(phi[lev].boxArray(), phi[lev].DistributionMap(), ncorr, 0);
+            }
+        }
+        for (int n = 0; n < ncomp; ++n) {
+            for (int lev = 0; lev <= finest_level; ++lev) {
+                store_diffusion_correction(corr.corr[lev], comps[n], phi[lev], n, rhs[lev], n,
+                                           *density[lev], 1);
+            }
+            corr.dt[comps[n]] = dt;
+        }
+    }
+}
+
+void
+DiffusionScalarOp::setMLMGOptions (MLMG& mlmg) const
+{
+    // The default bottom solver is BiCG
+    if (m_mg_bottom_solver == "smoother")
+    {
+        mlmg.setBottomSolver(MLMG::BottomSolver::smoother);
+    }
+    else if (m_mg_bottom_solver == "hypre")
+    {
+        mlmg.setBottomSolver(MLMG::BottomSolver::hypre);
+    }
+    // Maximum iterations for MultiGrid / ConjugateGradients
+    mlmg.setMaxIter(m_mg_max_iter);
+    mlmg.setMaxFmgIter(m_mg_max_fmg_iter);
+    mlmg.setBottomMaxIter(m_mg_bottom_maxiter);
+
+    // Verbosity for MultiGrid / ConjugateGradients
+    mlmg.setVerbose(m_mg_verbose);
+    mlmg.setBottomVerbose(m_mg_bottom_verbose);
+
+    mlmg.setPreSmooth(m_num_pre_smooth);
+    mlmg.setPostSmooth(m_num_post_smooth);
+}
+
 void
 DiffusionScalarOp::diffuse_vel_components (Vector<MultiFab*> const& vel,
                                            Vector<MultiFab*> const& density,
@@ -276,12 +556,20 @@ DiffusionScalarOp::diffuse_vel_components (Vector<MultiFab*> const& vel,
     //      a: rho
     //      b: mu
 
+    AMREX_ASSERT(vel[0]->nComp() == AMREX_SPACEDIM);
+
+    m_vel_stats.clear();
+
+    if (m_fused_vel_solve)
+    {
+        diffuse_vel_components_fused(vel, density, eta, dt);
+        return;
+    }
+
     if (m_verbose > 0) {
         amrex::Print() << "Diffusing velocity components one at a time ..." << std::endl;
     }
 
-    AMREX_ASSERT(vel[0]->nComp() == AMREX_SPACEDIM);
-
     const int finest_level = m_incflo->finestLevel();
 
     Vector<MultiFab> rhs(finest_level+1);
@@ -314,8 +602,7 @@ DiffusionScalarOp::diffuse_vel_components (Vector<MultiFab*> const& vel,
             }
 
             for (int lev = 0; lev <= finest_level; ++lev) {
-                Array<MultiFab,AMREX_SPACEDIM>
-                    b = m_incflo->average_scalar_eta_to_faces(lev, eta_comp, *eta[lev]);
+                auto const& b = m_incflo->get_eta_faces(lev, eta_comp, *eta[lev]);
 
                 m_eb_vel_solve_op->setBCoeffs(lev, GetArrOfConstPtrs(b), MLMG::Location::FaceCentroid);
             }
@@ -330,13 +617,14 @@ DiffusionScalarOp::diffuse_vel_components (Vector<MultiFab*> const& vel,
 
             m_reg_vel_solve_op->setScalars(1.0, dt);
             for (int lev = 0; lev <= finest_level; ++lev) {
-                m_reg_vel_solve_op->setACoeffs(lev, *density[lev]);
-            }
-
-            for (int lev = 0; lev <= finest_level; ++lev) {
-                Array<MultiFab,AMREX_SPACEDIM>
-                    b = m_incflo->average_scalar_eta_to_faces(lev, eta_comp, *eta[lev]);
-                m_reg_vel_solve_op->setBCoeffs(lev, GetArrOfConstPtrs(b));
+                if (m_incflo->useConstantCoeffDiffusion()) {
+                    m_reg_vel_solve_op->setACoeffs(lev, m_incflo->m_ro_0);
+                    m_reg_vel_solve_op->setBCoeffs(lev, m_incflo->m_mu);
+                } else {
+                    m_reg_vel_solve_op->setACoeffs(lev, *density[lev]);
+                    auto const& b = m_incflo->get_eta_faces(lev, eta_comp, *eta[lev]);
+                    m_reg_vel_solve_op->setBCoeffs(lev, GetArrOfConstPtrs(b));
+                }
             }
         }
 
@@ -380,29 +668,100 @@ DiffusionScalarOp::diffuse_vel_components (Vector<MultiFab*> const& vel,
         MLMG mlmg(*m_reg_vel_solve_op);
 #endif
 
-        // The default bottom solver is BiCG
-        if (m_mg_bottom_solver == "smoother")
-        {
-            mlmg.setBottomSolver(MLMG::BottomSolver::smoother);
-        }
-        else if (m_mg_bottom_solver == "hypre")
-        {
-            mlmg.setBottomSolver(MLMG::BottomSolver::hypre);
+        setMLMGOptions(mlmg);
+
+        solve(mlmg, phi, rhs, density, m_vel_corr, AMREX_SPACEDIM, {comp}, dt, m_vel_stats);
+    }
+}
+
+void
+DiffusionScalarOp::diffuse_vel_components_fused (Vector<MultiFab*> const& vel,
+                                                 Vector<MultiFab*> const& density,
+                                                 Vector<MultiFab const*> const& eta,
+                                                 Real dt)
+{
+    // Same system as in diffuse_vel_components, but all components go through a single
+    // AMREX_SPACEDIM-component solve. The coefficients are shared by the components;
+    // only the domain BCs, set once at construction, differ per component.
+
+    if (m_verbose > 0) {
+        amrex::Print() << "Diffusing velocity components together ..." << std::endl;
+    }
+
+    const int finest_level = m_incflo->finestLevel();
+    const int eta_comp = 0;
+
+    Vector<MultiFab> rhs(finest_level+1);
+    Vector<MultiFab> phi;
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        rhs[lev].define(vel[lev]->boxArray(), vel[lev]->DistributionMap(), AMREX_SPACEDIM, 0);
+
+        vel[lev]->FillBoundary(m_incflo->Geom(lev).periodicity());
+        phi.emplace_back(*vel[lev], amrex::make_alias, 0, AMREX_SPACEDIM);
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(rhs[lev],TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+            Box const& bx = mfi.tilebox();
+            Array4<Real> const& rhs_a = rhs[lev].array(mfi);
+            Array4<Real const> const& vel_a = vel[lev]->const_array(mfi);
+            Array4<Real const> const& rho_a = density[lev]->const_array(mfi);
+            amrex::ParallelFor(bx, AMREX_SPACEDIM,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+            {
+                rhs_a(i,j,k,n) = rho_a(i,j,k) * vel_a(i,j,k,n);
+            });
         }
-        // Maximum iterations for MultiGrid / ConjugateGradients
-        mlmg.setMaxIter(m_mg_max_iter);
-        mlmg.setMaxFmgIter(m_mg_max_fmg_iter);
-        mlmg.setBottomMaxIter(m_mg_bottom_maxiter);
+    }
+
+#ifdef AMREX_USE_EB
+    if (m_eb_vel_solve_op)
+    {
+        m_eb_vel_solve_op->setScalars(1.0, dt);
+        for (int lev = 0; lev <= finest_level; ++lev) {
+            m_eb_vel_solve_op->setACoeffs(lev, *density[lev]);
+
+            if (m_incflo->hasEBFlow()) {
+                m_eb_vel_solve_op->setEBDirichlet(lev, *m_incflo->get_velocity_eb()[lev], *eta[lev]);
+            } else {
+                m_eb_vel_solve_op->setEBHomogDirichlet(lev, *eta[lev]);
+            }
 
-        // Verbosity for MultiGrid / ConjugateGradients
-        mlmg.setVerbose(m_mg_verbose);
-        mlmg.setBottomVerbose(m_mg_bottom_verbose);
+            auto const& b = m_incflo->get_eta_faces(lev, eta_comp, *eta[lev]);
+            m_eb_vel_solve_op->setBCoeffs(lev, GetArrOfConstPtrs(b), MLMG::Location::FaceCentroid);
 
-        mlmg.setPreSmooth(m_num_pre_smooth);
-        mlmg.setPostSmooth(m_num_post_smooth);
+            m_eb_vel_solve_op->setLevelBC(lev, &phi[lev]);
+        }
+    }
+    else
+#endif
+    {
+        m_reg_vel_solve_op->setScalars(1.0, dt);
+        for (int lev = 0; lev <= finest_level; ++lev) {
+            if (m_incflo->useConstantCoeffDiffusion()) {
+                m_reg_vel_solve_op->setACoeffs(lev, m_incflo->m_ro_0);
+                m_reg_vel_solve_op->setBCoeffs(lev, m_incflo->m_mu);
+            } else {
+                m_reg_vel_solve_op->setACoeffs(lev, *density[lev]);
+                auto const& b = m_incflo->get_eta_faces(lev, eta_comp, *eta[lev]);
+                m_reg_vel_solve_op->setBCoeffs(lev, GetArrOfConstPtrs(b));
+            }
 
-        mlmg.solve(GetVecOfPtrs(phi), GetVecOfConstPtrs(rhs), m_mg_rtol, m_mg_atol);
+            m_reg_vel_solve_op->setLevelBC(lev, &phi[lev]);
+        }
     }
+
+#ifdef AMREX_USE_EB
+    MLMG mlmg(m_eb_vel_solve_op ? static_cast<MLLinOp&>(*m_eb_vel_solve_op) : static_cast<MLLinOp&>(*m_reg_vel_solve_op));
+#else
+    MLMG mlmg(*m_reg_vel_solve_op);
+#endif
+
+    setMLMGOptions(mlmg);
+
+    solve(mlmg, phi, rhs, density, m_vel_corr, AMREX_SPACEDIM, {AMREX_D_DECL(0,1,2)}, dt, m_vel_stats);
 }
 
 void DiffusionScalarOp::compute_laps (Vector<MultiFab*> const& a_laps,
@@ -457,8 +816,7 @@ void DiffusionScalarOp::compute_laps (Vector<MultiFab*> const& a_laps,
                 laps_comp.emplace_back(laps_tmp[lev],amrex::make_alias,comp,1);
                 scalar_comp.emplace_back(scalar[lev],amrex::make_alias,comp,1);
 
-                Array<MultiFab,AMREX_SPACEDIM>
-                    b = m_incflo->average_scalar_eta_to_faces(lev, eta_comp, *a_eta[lev]);
+                auto const& b = m_incflo->get_eta_faces(lev, eta_comp, *a_eta[lev]);
 
                 m_eb_scal_apply_op->setBCoeffs(lev, GetArrOfConstPtrs(b), MLMG::Location::FaceCentroid);
                 m_eb_scal_apply_op->setLevelBC(lev, &scalar_comp[lev]);
@@ -495,10 +853,12 @@ void DiffusionScalarOp::compute_laps (Vector<MultiFab*> const& a_laps,
             for (int lev = 0; lev <= finest_level; ++lev) {
                 laps_comp.emplace_back(*a_laps[lev],amrex::make_alias,comp,1);
                 scalar_comp.emplace_back(scalar[lev],amrex::make_alias,comp,1);
-                Array<MultiFab,AMREX_SPACEDIM>
-                    b = m_incflo->average_scalar_eta_to_faces(lev, eta_comp, *a_eta[lev]);
-
-                m_reg_scal_apply_op->setBCoeffs(lev, GetArrOfConstPtrs(b));
+                if (m_incflo->useConstantTracerDiffusion()) {
+                    m_reg_scal_apply_op->setBCoeffs(lev, m_incflo->m_mu_s[eta_comp]);
+                } else {
+                    auto const& b = m_incflo->get_eta_faces(lev, eta_comp, *a_eta[lev]);
+                    m_reg_scal_apply_op->setBCoeffs(lev, GetArrOfConstPtrs(b));
+                }
                 m_reg_scal_apply_op->setLevelBC(lev, &scalar_comp[lev]);
             }
 
@@ -573,8 +933,7 @@ void DiffusionScalarOp::compute_divtau (Vector<MultiFab*> const& a_divtau,
                    vel_single.emplace_back(       vel[lev],amrex::make_alias,comp,1);
                 m_eb_vel_apply_op->setLevelBC(lev, &vel_single[lev]);
 
-                Array<MultiFab,AMREX_SPACEDIM> b =
-                    m_incflo->average_scalar_eta_to_faces(lev, eta_comp, *a_eta[lev]);
+                auto const& b = m_incflo->get_eta_faces(lev, eta_comp, *a_eta[lev]);
                 m_eb_vel_apply_op->setBCoeffs(lev, GetArrOfConstPtrs(b), MLMG::Location::FaceCentroid);
             }
 
@@ -596,20 +955,21 @@ void DiffusionScalarOp::compute_divtau (Vector<MultiFab*> const& a_divtau,
         // We want to return div (mu grad)) phi
         m_reg_vel_apply_op->setScalars(0.0, -1.0);
 
-        // This should have no effect since the first scalar is 0
-        for (int lev = 0; lev <= finest_level; ++lev) {
-            m_reg_vel_apply_op->setACoeffs(lev, *a_density[lev]);
-        }
-
         int eta_comp = 0;
         Vector<MultiFab> divtau_single;
         Vector<MultiFab>    vel_single;
 
+        // The A coefficients should have no effect since the first scalar is 0
         for (int lev = 0; lev <= finest_level; ++lev)
         {
-            Array<MultiFab,AMREX_SPACEDIM>
-                b = m_incflo->average_scalar_eta_to_faces(lev, eta_comp, *a_eta[lev]);
-            m_reg_vel_apply_op->setBCoeffs(lev, GetArrOfConstPtrs(b));
+            if (m_incflo->useConstantCoeffDiffusion()) {
+                m_reg_vel_apply_op->setACoeffs(lev, m_incflo->m_ro_0);
+                m_reg_vel_apply_op->setBCoeffs(lev, m_incflo->m_mu);
+            } else {
+                m_reg_vel_apply_op->setACoeffs(lev, *a_density[lev]);
+                auto const& b = m_incflo->get_eta_faces(lev, eta_comp, *a_eta[lev]);
+                m_reg_vel_apply_op->setBCoeffs(lev, GetArrOfConstPtrs(b));
+            }
         }
 
         for (int comp = 0; comp < a_divtau[0]->nComp(); ++comp)
@@ -15,6 +15,9 @@ DiffusionTensorOp::DiffusionTensorOp (incflo* a_incflo)
 
     int finest_level = m_incflo->finestLevel();
 
+    m_grids = m_incflo->boxArray(0,finest_level);
+    m_dmap  = m_incflo->DistributionMap(0,finest_level);
+
     LPInfo info_solve;
     info_solve.setMaxCoarseningLevel(m_mg_max_coarsening_level);
     LPInfo info_apply;
@@ -38,7 +41,8 @@ DiffusionTensorOp::DiffusionTensorOp (incflo* a_incflo)
                                        m_incflo->get_diffuse_tensor_bc(Orientation::high));
         }
 
-        if (m_incflo->need_divtau() || m_incflo->useTensorCorrection())
+        if (m_incflo->need_divtau() || m_incflo->useTensorCorrection() ||
+            m_incflo->useNewtonViscosity())
         {
             m_eb_apply_op.reset(new MLEBTensorOp(m_incflo->Geom(0,finest_level),
                                                  m_incflo->boxArray(0,finest_level),
@@ -63,7 +67,8 @@ DiffusionTensorOp::DiffusionTensorOp (incflo* a_incflo)
                                         m_incflo->get_diffuse_tensor_bc(Orientation::high));
         }
 
-        if (m_incflo->need_divtau() || m_incflo->useTensorCorrection())
+        if (m_incflo->need_divtau() || m_incflo->useTensorCorrection() ||
+            m_incflo->useNewtonViscosity())
         {
             m_reg_apply_op.reset(new MLTensorOp(m_incflo->Geom(0,finest_level),
                                                 m_incflo->boxArray(0,finest_level),
@@ -95,6 +100,23 @@ DiffusionTensorOp::readParameters ()
 
     pp.query("num_pre_smooth", m_num_pre_smooth);
     pp.query("num_post_smooth", m_num_post_smooth);
+
+    pp.query("warm_start", m_warm_start);
+}
+
+bool
+DiffusionTensorOp::needsRebuild () const
+{
+    const int finest_level = m_incflo->finestLevel();
+    if (static_cast<int>(m_grids.size()) != finest_level+1) return true;
+
+    for (int lev = 0; lev <= finest_level; ++lev) {
+        if (m_grids[lev] != m_incflo->boxArray(lev) ||
+            m_dmap[lev]  != m_incflo->DistributionMap(lev)) {
+            return true;
+        }
+    }
+    return false;
 }
 
 void
@@ -129,7 +151,7 @@ DiffusionTensorOp::diffuse_velocity (Vector<MultiFab*> const& velocity,
         for (int lev = 0; lev <= finest_level; ++lev) {
             m_eb_solve_op->setACoeffs(lev, *density[lev]);
 
-            Array<MultiFab,AMREX_SPACEDIM> b = m_incflo->average_velocity_eta_to_faces(lev, *eta[lev]);
+            auto const& b = m_incflo->get_eta_faces(lev, 0, *eta[lev]);
 
             m_eb_solve_op->setShearViscosity(lev, GetArrOfConstPtrs(b), MLMG::Location::FaceCentroid);
 
@@ -145,9 +167,14 @@ DiffusionTensorOp::diffuse_velocity (Vector<MultiFab*> const& velocity,
     {
         m_reg_solve_op->setScalars(1.0, dt);
         for (int lev = 0; lev <= finest_level; ++lev) {
-            m_reg_solve_op->setACoeffs(lev, *density[lev]);
-            Array<MultiFab,AMREX_SPACEDIM> b = m_incflo->average_velocity_eta_to_faces(lev, *eta[lev]);
-            m_reg_solve_op->setShearViscosity(lev, GetArrOfConstPtrs(b));
+            if (m_incflo->useConstantCoeffDiffusion()) {
+                m_reg_solve_op->setACoeffs(lev, m_incflo->m_ro_0);
+                m_reg_solve_op->setShearViscosity(lev, m_incflo->m_mu);
+            } else {
+                m_reg_solve_op->setACoeffs(lev, *density[lev]);
+                auto const& b = m_incflo->get_eta_faces(lev, 0, *eta[lev]);
+                m_reg_solve_op->setShearViscosity(lev, GetArrOfConstPtrs(b));
+            }
         }
     }
 
@@ -208,7 +235,35 @@ DiffusionTensorOp::diffuse_velocity (Vector<MultiFab*> const& velocity,
     mlmg.setPreSmooth(m_num_pre_smooth);
     mlmg.setPostSmooth(m_num_post_smooth);
 
+    // Start from u* plus the previous implicit correction, rescaled for dt
+    bool warm_start = m_warm_start && (m_corr_dt > 0.0);
+    if (warm_start) {
+        for (int lev = 0; lev <= finest_level; ++lev) {
+            MultiFab::Saxpy(*velocity[lev], dt/m_corr_dt, m_corr[lev], 0, 0, AMREX_SPACEDIM, 0);
+        }
+    }
+
     mlmg.solve(velocity, GetVecOfConstPtrs(rhs), m_mg_rtol, m_mg_atol);
+
+    m_stats = DiffusionSolveStats(mlmg, warm_start);
+    if (m_verbose > 0) {
+        amrex::Print() << "  Tensor diffusion solve: " << m_stats.num_iters << " MLMG iterations"
+                       << (warm_start ? " (warm start)" : "") << std::endl;
+    }
+
+    if (m_warm_start)
+    {
+        m_corr.resize(finest_level+1);
+        for (int lev = 0; lev <= finest_level; ++lev) {
+            if (!m_corr[lev].ok()) {
+                m_corr[lev].define(velocity[lev]->boxArray(), velocity[lev]->DistributionMap(),
+                                   AMREX_SPACEDIM, 0);
+            }
+            store_diffusion_correction(m_corr[lev], 0, *velocity[lev], 0, rhs[lev], 0,
+                                       *density[lev], AMREX_SPACEDIM);
+        }
+        m_corr_dt = dt;
+    }
 }
 
 void DiffusionTensorOp::compute_divtau (Vector<MultiFab*> const& a_divtau,
@@ -250,7 +305,7 @@ void DiffusionTensorOp::compute_divtau (Vector<MultiFab*> const& a_divtau,
         for (int lev = 0; lev <= finest_level; ++lev) {
             m_eb_apply_op->setACoeffs(lev, *a_density[lev]);
 
-            Array<MultiFab,AMREX_SPACEDIM> b = m_incflo->average_velocity_eta_to_faces(lev, *a_eta[lev]);
+            auto const& b = m_incflo->get_eta_faces(lev, 0, *a_eta[lev]);
 
             m_eb_apply_op->setShearViscosity(lev, GetArrOfConstPtrs(b), MLMG::Location::FaceCentroid);
 
@@ -276,9 +331,14 @@ void DiffusionTensorOp::compute_divtau (Vector<MultiFab*> const& a_divtau,
         // We want to return div (mu grad)) phi
         m_reg_apply_op->setScalars(0.0, -1.0);
         for (int lev = 0; lev <= finest_level; ++lev) {
-            m_reg_apply_op->setACoeffs(lev, *a_density[lev]);
-            Array<MultiFab,AMREX_SPACEDIM> b = m_incflo->average_velocity_eta_to_faces(lev, *a_eta[lev]);
-            m_reg_apply_op->setShearViscosity(lev, GetArrOfConstPtrs(b));
+            if (m_incflo->useConstantCoeffDiffusion()) {
+                m_reg_apply_op->setACoeffs(lev, m_incflo->m_ro_0);
+                m_reg_apply_op->setShearViscosity(lev, m_incflo->m_mu);
+            } else {
+                m_reg_apply_op->setACoeffs(lev, *a_density[lev]);
+                auto const& b = m_incflo->get_eta_faces(lev, 0, *a_eta[lev]);
+                m_reg_apply_op->setShearViscosity(lev, GetArrOfConstPtrs(b));
+            }
             m_reg_apply_op->setLevelBC(lev, &velocity[lev]);
         }
 
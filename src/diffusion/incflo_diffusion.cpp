@@ -8,6 +8,11 @@ incflo::compute_divtau(Vector<MultiFab      *> const& divtau,
                        Vector<MultiFab const*> const& density,
                        Vector<MultiFab const*> const& eta)
 {
+    if (useFusedDivtau()) {
+        compute_divtau_fused(divtau, vel, density);
+        return;
+    }
+
     if (use_tensor_correction) {
 
         get_diffusion_tensor_op()->compute_divtau(divtau, vel, density, eta);
@@ -88,20 +93,185 @@ incflo::diffuse_velocity(Vector<MultiFab      *> const& vel,
     }
 }
 
+// Implicit velocity diffusion with the viscosity of the new velocity instead of
+// a lagged one. The first solve uses the given eta; each further solve starts
+// again from the velocity before diffusion with
+//   Picard: eta recomputed from the latest iterate u^k
+//   Newton: the scalar tangent viscosity eta_t of u^k, and the right-hand side
+//           corrected by dt*(divtau(u^k;eta) - divtau(u^k;eta_t)), so that the
+//           fixed point is still the solve with eta(u). eta_t is isotropic, so
+//           this is a quasi-Newton iteration without quadratic convergence
+// until the max norm of the velocity change relative to that of the velocity
+// is below m_visc_nonlinear_tol. The diffusion operators are kept across solves.
+void
+incflo::diffuse_velocity_nonlinear (Vector<MultiFab*> const& vel,
+                                    Vector<MultiFab*> const& density,
+                                    Vector<MultiFab*> const& eta,
+                                    Real time, Real dt_diff)
+{
+    BL_PROFILE("incflo::diffuse_velocity_nonlinear");
+
+    const bool newton = (m_visc_nonlinear == ViscNonlinearType::newton);
+    // The strain rate is needed in the ghost cells of eta
+    const int ng_vel = 2;
+
+    Vector<MultiFab> vel_rhs(finest_level+1);
+    Vector<MultiFab> dvel(finest_level+1);
+    Vector<MultiFab> divtau(finest_level+1);
+    Vector<MultiFab> divtau_t(finest_level+1);
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        int ng = vel[lev]->nGrow();
+        vel_rhs[lev].define(grids[lev], dmap[lev], AMREX_SPACEDIM, ng, MFInfo(), Factory(lev));
+        MultiFab::Copy(vel_rhs[lev], *vel[lev], 0, 0, AMREX_SPACEDIM, ng);
+        dvel[lev].define(grids[lev], dmap[lev], AMREX_SPACEDIM, 0, MFInfo(), Factory(lev));
+        if (newton) {
+            divtau  [lev].define(grids[lev], dmap[lev], AMREX_SPACEDIM, 0, MFInfo(), Factory(lev));
+            divtau_t[lev].define(grids[lev], dmap[lev], AMREX_SPACEDIM, 0, MFInfo(), Factory(lev));
+            auto& ws = get_workspace(lev);
+            if (!ws.vel_eta_t.ok()) {
+                ws.vel_eta_t.define(grids[lev], dmap[lev], 1, 1, MFInfo(), Factory(lev));
+            }
+        }
+    }
+    Vector<MultiFab*> eta_t = newton ? get_workspace(&Workspace::vel_eta_t) : Vector<MultiFab*>{};
+
+    // divtau of the operator that diffuse_velocity solves with
+    auto apply_divtau = [&] (Vector<MultiFab> & a_divtau, Vector<MultiFab*> const& a_eta)
+    {
+        if (use_tensor_solve) {
+            get_diffusion_tensor_op()->compute_divtau(GetVecOfPtrs(a_divtau), GetVecOfConstPtrs(vel),
+                                                      GetVecOfConstPtrs(density), GetVecOfConstPtrs(a_eta));
+        } else {
+            get_diffusion_scalar_op()->compute_divtau(GetVecOfPtrs(a_divtau), GetVecOfConstPtrs(vel),
+                                                      GetVecOfConstPtrs(density), GetVecOfConstPtrs(a_eta));
+            // The scalar divtau is not divided by rho, but the correction is
+            // added to the velocity
+            for (int lev = 0; lev <= finest_level; ++lev) {
+                for (int n = 0; n < AMREX_SPACEDIM; ++n) {
+                    MultiFab::Divide(a_divtau[lev], *density[lev], 0, n, 1, 0);
+                }
+            }
+        }
+    };
+
+    diffuse_velocity(vel, density, GetVecOfConstPtrs(eta), dt_diff);
+
+    int iter = 1;
+    Real rel_change = std::numeric_limits<Real>::max();
+    for (; iter < m_visc_nonlinear_max_iter; ++iter)
+    {
+        for (int lev = 0; lev <= finest_level; ++lev) {
+            fillpatch_velocity(lev, time, *vel[lev], ng_vel);
+        }
+        compute_viscosity(eta, density, vel, time, 1);
+
+        Vector<MultiFab*> solve_eta = eta;
+        if (newton) {
+            compute_tangent_viscosity(eta_t, vel, 1);
+            apply_divtau(divtau  , eta);
+            apply_divtau(divtau_t, eta_t);
+            solve_eta = eta_t;
+        }
+
+        for (int lev = 0; lev <= finest_level; ++lev)
+        {
+            MultiFab::Copy(dvel[lev], *vel[lev], 0, 0, AMREX_SPACEDIM, 0);
+            MultiFab::Copy(*vel[lev], vel_rhs[lev], 0, 0, AMREX_SPACEDIM, vel[lev]->nGrow());
+            if (newton) {
+                MultiFab::Saxpy(*vel[lev],  dt_diff, divtau  [lev], 0, 0, AMREX_SPACEDIM, 0);
+                MultiFab::Saxpy(*vel[lev], -dt_diff, divtau_t[lev], 0, 0, AMREX_SPACEDIM, 0);
+            }
+        }
+
+        diffuse_velocity(vel, density, GetVecOfConstPtrs(solve_eta), dt_diff);
+
+        Real norm_dvel = 0.0;
+        Real norm_vel = 0.0;
+        for (int lev = 0; lev <= finest_level; ++lev)
+        {
+            MultiFab::Subtract(dvel[lev], *vel[lev], 0, 0, AMREX_SPACEDIM, 0);
+            for (int n = 0; n < AMREX_SPACEDIM; ++n) {
+                norm_dvel = amrex::max(norm_dvel, dvel[lev].norm0(n, 0, true));
+                norm_vel  = amrex::max(norm_vel , vel[lev]->norm0(n, 0, true));
+            }
+        }
+        ParallelDescriptor::ReduceRealMax(norm_dvel);
+        ParallelDescriptor::ReduceRealMax(norm_vel);
+        rel_change = (norm_vel > 0.0) ? norm_dvel / norm_vel : norm_dvel;
+
+        if (m_verbose > 1) {
+            amrex::Print() << "  Viscosity iteration " << iter
+                           << ": relative velocity change = " << rel_change << std::endl;
+        }
+
+        if (rel_change <= m_visc_nonlinear_tol) break;
+    }
+
+    if (m_verbose > 0) {
+        if (rel_change <= m_visc_nonlinear_tol) {
+            amrex::Print() << "Viscosity iterations converged in " << iter+1 << " solves" << std::endl;
+        } else if (m_visc_nonlinear_max_iter > 1) {
+            amrex::Print() << "Viscosity iterations not converged after " << iter << " solves"
+                           << ", relative velocity change = " << rel_change << std::endl;
+        }
+    }
+}
+
 DiffusionTensorOp*
 incflo::get_diffusion_tensor_op ()
 {
-    if (!m_diffusion_tensor_op) m_diffusion_tensor_op.reset(new DiffusionTensorOp(this));
+    if (!m_diffusion_tensor_op || m_diffusion_tensor_op->needsRebuild()) {
+        Real strt_time = ParallelDescriptor::second();
+        m_diffusion_tensor_op.reset(new DiffusionTensorOp(this));
+        Real build_time = ParallelDescriptor::second() - strt_time;
+        m_diffusion_op_build_time += build_time;
+        if (m_verbose > 0) {
+            Real total_time = m_diffusion_op_build_time;
+            ParallelDescriptor::ReduceRealMax(build_time, ParallelDescriptor::IOProcessorNumber());
+            ParallelDescriptor::ReduceRealMax(total_time, ParallelDescriptor::IOProcessorNumber());
+            amrex::Print() << "Time to build tensor diffusion operators: " << build_time
+                           << " (total so far: " << total_time << ")" << std::endl;
+        }
+    }
     return m_diffusion_tensor_op.get();
 }
 
 DiffusionScalarOp*
 incflo::get_diffusion_scalar_op ()
 {
-    if (!m_diffusion_scalar_op) m_diffusion_scalar_op.reset(new DiffusionScalarOp(this));
+    if (!m_diffusion_scalar_op || m_diffusion_scalar_op->needsRebuild()) {
+        Real strt_time = ParallelDescriptor::second();
+        m_diffusion_scalar_op.reset(new DiffusionScalarOp(this));
+        Real build_time = ParallelDescriptor::second() - strt_time;
+        m_diffusion_op_build_time += build_time;
+        if (m_verbose > 0) {
+            Real total_time = m_diffusion_op_build_time;
+            ParallelDescriptor::ReduceRealMax(build_time, ParallelDescriptor::IOProcessorNumber());
+            ParallelDescriptor::ReduceRealMax(total_time, ParallelDescriptor::IOProcessorNumber());
+            amrex::Print() << "Time to build scalar diffusion operators: " << build_time
+                           << " (total so far: " << total_time << ")" << std::endl;
+        }
+    }
     return m_diffusion_scalar_op.get();
 }
 
+int
+incflo::lastVelocitySolveIters () const
+{
+    int r = 0;
+    if (use_tensor_solve) {
+        if (m_diffusion_tensor_op) {
+            r = m_diffusion_tensor_op->solveStats().num_iters;
+        }
+    } else if (m_diffusion_scalar_op) {
+        for (auto const& stats : m_diffusion_scalar_op->velocitySolveStats()) {
+            r = amrex::max(r, stats.num_iters);
+        }
+    }
+    return r;
+}
+
 Vector<Array<LinOpBCType,AMREX_SPACEDIM> >
 incflo::get_diffuse_tensor_bc (Orientation::Side side) const noexcept
 {
@@ -246,6 +416,12 @@ incflo::get_diffuse_scalar_bc (Orientation::Side side) const noexcept
 
 Array<MultiFab,AMREX_SPACEDIM>
 incflo::average_velocity_eta_to_faces (int lev, MultiFab const& cc_eta) const
+{
+    return average_scalar_eta_to_faces(lev, 0, cc_eta);
+}
+
+Array<MultiFab,AMREX_SPACEDIM>
+incflo::average_scalar_eta_to_faces (int lev, int comp, MultiFab const& cc_eta) const
 {
     const auto& ba = cc_eta.boxArray();
     const auto& dm = cc_eta.DistributionMap();
@@ -256,42 +432,58 @@ incflo::average_velocity_eta_to_faces (int lev, MultiFab const& cc_eta) const
                                               dm, 1, 0, MFInfo(), fact),
                                      MultiFab(amrex::convert(ba,IntVect::TheDimensionVector(2)),
                                               dm, 1, 0, MFInfo(), fact))};
+    fill_eta_faces(lev, comp, cc_eta, r);
+    return r;
+}
 
+void
+incflo::fill_eta_faces (int lev, int comp, MultiFab const& cc_eta,
+                        Array<MultiFab,AMREX_SPACEDIM>& fc) const
+{
+    MultiFab cc(cc_eta, amrex::make_alias, comp, 1);
 #ifdef AMREX_USE_EB
     // Note we use the scalar bc's here only to know when the bc is ext_dir
     //      (this should be the same for scalar and eta)
-    EB_interp_CellCentroid_to_FaceCentroid (cc_eta, GetArrOfPtrs(r), 0, 0, 1, geom[lev],
+    EB_interp_CellCentroid_to_FaceCentroid (cc, GetArrOfPtrs(fc), 0, 0, 1, geom[lev],
                                             get_tracer_bcrec());
-    // amrex::average_cellcenter_to_face(GetArrOfPtrs(r), cc_eta, Geom(lev));
 #else
-    amrex::average_cellcenter_to_face(GetArrOfPtrs(r), cc_eta, Geom(lev));
+    amrex::average_cellcenter_to_face(GetArrOfPtrs(fc), cc, Geom(lev));
 #endif
+    fixup_eta_on_domain_faces(lev, fc, cc);
+}
 
-    fixup_eta_on_domain_faces(lev, r, cc_eta);
-    return r;
+Array<MultiFab,AMREX_SPACEDIM> const&
+incflo::get_eta_faces (int lev, int comp, MultiFab const& cc_eta)
+{
+    for (auto& e : m_eta_faces[lev]) {
+        // Compare the layout too in case cc_eta reuses the address of a freed MultiFab
+        if (e->cc == &cc_eta && e->comp == comp &&
+            e->fc[0].DistributionMap() == cc_eta.DistributionMap() &&
+            e->fc[0].boxArray().CellEqual(cc_eta.boxArray()))
+        {
+            if (!e->valid) {
+                fill_eta_faces(lev, comp, cc_eta, e->fc);
+                e->valid = true;
+            }
+            return e->fc;
+        }
+    }
+
+    auto e = std::make_unique<EtaFaces>();
+    e->cc = &cc_eta;
+    e->comp = comp;
+    e->fc = average_scalar_eta_to_faces(lev, comp, cc_eta);
+    e->valid = true;
+    m_eta_faces[lev].push_back(std::move(e));
+    return m_eta_faces[lev].back()->fc;
 }
 
-Array<MultiFab,AMREX_SPACEDIM>
-incflo::average_scalar_eta_to_faces (int lev, int comp, MultiFab const& cc_eta) const
+void
+incflo::invalidate_eta_faces (int lev, MultiFab const& cc_eta)
 {
-    const auto& ba = cc_eta.boxArray();
-    const auto& dm = cc_eta.DistributionMap();
-    const auto& fact = cc_eta.Factory();
-    MultiFab cc(cc_eta, amrex::make_alias, comp, 1);
-    Array<MultiFab,AMREX_SPACEDIM> r{AMREX_D_DECL(MultiFab(amrex::convert(ba,IntVect::TheDimensionVector(0)),
-                                              dm, 1, 0, MFInfo(), fact),
-                                     MultiFab(amrex::convert(ba,IntVect::TheDimensionVector(1)),
-                                              dm, 1, 0, MFInfo(), fact),
-                                     MultiFab(amrex::convert(ba,IntVect::TheDimensionVector(2)),
-                                              dm, 1, 0, MFInfo(), fact))};
-#ifdef AMREX_USE_EB
-    EB_interp_CellCentroid_to_FaceCentroid (cc, GetArrOfPtrs(r), 0, 0, 1, geom[lev],
-                                            get_tracer_bcrec());
-#else
-    amrex::average_cellcenter_to_face(GetArrOfPtrs(r), cc, Geom(lev));
-#endif
-    fixup_eta_on_domain_faces(lev, r, cc);
-    return r;
+    for (auto& e : m_eta_faces[lev]) {
+        if (e->cc == &cc_eta) e->valid = false;
+    }
 }
 
 void
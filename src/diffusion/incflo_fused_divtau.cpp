@@ -0,0 +1,159 @@
+#include <incflo.H>
+#include <incflo_rheology_K.H>
+
+using namespace amrex;
+
+namespace {
+
+// Velocity gradient G[n][m] = d u_n / d x_m on the lower d-face of cell iv.
+// On a domain face where the ghost cell holds the boundary value (ext_dir),
+// the normal derivative is taken over half a cell and the tangential ones
+// are those of the boundary values.
+AMREX_GPU_DEVICE AMREX_FORCE_INLINE
+void face_velocity_gradient (IntVect const& iv, int d, Array4<Real const> const& vel,
+                             Box const& domain, GpuArray<Real,AMREX_SPACEDIM> const& idx,
+                             BCRec const* bcrec, Real G[AMREX_SPACEDIM][AMREX_SPACEDIM]) noexcept
+{
+    IntVect ivm = iv;
+    ivm[d] -= 1;
+
+    const bool on_lo = (iv[d] == domain.smallEnd(d));
+    const bool on_hi = (iv[d] == domain.bigEnd(d)+1);
+
+    for (int n = 0; n < AMREX_SPACEDIM; ++n)
+    {
+        const bool ext = (on_lo && bcrec[n].lo(d) == BCType::ext_dir) ||
+                         (on_hi && bcrec[n].hi(d) == BCType::ext_dir);
+
+        for (int m = 0; m < AMREX_SPACEDIM; ++m)
+        {
+            if (m == d) {
+                G[n][m] = (vel(iv,n) - vel(ivm,n)) * idx[d] * (ext ? 2.0 : 1.0);
+            } else {
+                IntVect e(0);
+                e[m] = 1;
+                Real c  = 0.5 * (vel(iv +e,n) - vel(iv -e,n)) * idx[m];
+                Real cm = 0.5 * (vel(ivm+e,n) - vel(ivm-e,n)) * idx[m];
+                if (ext) {
+                    G[n][m] = on_lo ? cm : c;
+                } else {
+                    G[n][m] = 0.5 * (c + cm);
+                }
+            }
+        }
+    }
+}
+
+template <typename Viscosity>
+void fused_divtau (Box const& bx, Array4<Real> const& divtau,
+                   Array4<Real const> const& vel, Array4<Real const> const& rho,
+                   Box const& domain, GpuArray<Real,AMREX_SPACEDIM> const& idx,
+                   BCRec const* bcrec, bool tensor, Viscosity const& viscosity)
+{
+    Array<FArrayBox,AMREX_SPACEDIM> flux;
+    Array<Array4<Real>,AMREX_SPACEDIM> flx;
+    Array<Elixir,AMREX_SPACEDIM> eli;
+
+    for (int d = 0; d < AMREX_SPACEDIM; ++d)
+    {
+        Box const& fbx = amrex::surroundingNodes(bx,d);
+        flux[d].resize(fbx, AMREX_SPACEDIM);
+        eli[d] = flux[d].elixir();
+        flx[d] = flux[d].array();
+        Array4<Real> const& f = flx[d];
+
+        amrex::ParallelFor(fbx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            IntVect iv(AMREX_D_DECL(i,j,k));
+            Real G[AMREX_SPACEDIM][AMREX_SPACEDIM];
+            face_velocity_gradient(iv, d, vel, domain, idx, bcrec, G);
+
+            // Same strain rate as incflo_strainrate, but on the face
+            Real sr2 = 0.0;
+            Real divu = 0.0;
+            for (int n = 0; n < AMREX_SPACEDIM; ++n) {
+                sr2 += 2.0 * G[n][n] * G[n][n];
+                divu += G[n][n];
+                for (int m = n+1; m < AMREX_SPACEDIM; ++m) {
+                    sr2 += (G[n][m]+G[m][n]) * (G[n][m]+G[m][n]);
+                }
+            }
+            Real eta = viscosity(std::sqrt(sr2));
+
+            for (int n = 0; n < AMREX_SPACEDIM; ++n) {
+                Real g = G[n][d];
+                if (tensor) {
+                    g += G[d][n];
+                    if (n == d) g -= (2.0/3.0) * divu;
+                }
+                f(i,j,k,n) = eta * g;
+            }
+        });
+    }
+
+    AMREX_D_TERM(Array4<Real const> const& fx = flx[0];,
+                 Array4<Real const> const& fy = flx[1];,
+                 Array4<Real const> const& fz = flx[2];);
+
+    amrex::ParallelFor(bx, AMREX_SPACEDIM, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+    {
+        Real r = AMREX_D_TERM(  (fx(i+1,j,k,n) - fx(i,j,k,n)) * idx[0],
+                              + (fy(i,j+1,k,n) - fy(i,j,k,n)) * idx[1],
+                              + (fz(i,j,k+1,n) - fz(i,j,k,n)) * idx[2]);
+        // As in the operators, only the tensor divtau is divided by rho
+        divtau(i,j,k,n) = tensor ? r / rho(i,j,k) : r;
+    });
+}
+
+}
+
+//
+// divtau = div(tau) / rho (div(eta grad u) without use_tensor_solve, as returned
+// by DiffusionScalarOp), with the viscosity evaluated from the face strain rate
+// inside the flux kernel rather than read from a cell-centred eta
+//
+void
+incflo::compute_divtau_fused (Vector<MultiFab      *> const& divtau,
+                              Vector<MultiFab const*> const& vel,
+                              Vector<MultiFab const*> const& density)
+{
+    BL_PROFILE("incflo::compute_divtau_fused()");
+
+    rheology::ViscosityParams params;
+    params.mu = m_mu;
+    params.n_flow = m_n_0;
+    params.tau_0 = m_tau_0;
+    params.eta_0 = m_eta_0;
+    params.papa_reg = m_papa_reg;
+
+    const bool tensor = use_tensor_solve;
+    BCRec const* bcrec = get_velocity_bcrec_device_ptr();
+
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        Box const& domain = geom[lev].Domain();
+        auto const idx = geom[lev].InvCellSizeArray();
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(*divtau[lev],TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            Real strt_cost = ParallelDescriptor::second();
+
+            Box const& bx = mfi.tilebox();
+            Array4<Real> const& divtau_arr = divtau[lev]->array(mfi);
+            Array4<Real const> const& vel_arr = vel[lev]->const_array(mfi);
+            Array4<Real const> const& rho_arr = density[lev]->const_array(mfi);
+
+            rheology::dispatch_viscosity(m_fluid_model, params,
+                [&] (auto const& viscosity)
+                {
+                    fused_divtau(bx, divtau_arr, vel_arr, rho_arr, domain, idx, bcrec,
+                                 tensor, viscosity);
+                });
+
+            if (collect_costs()) add_cost(lev, mfi, strt_cost);
+        }
+    }
+}
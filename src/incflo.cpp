@@ -130,6 +130,15 @@ void incflo::Evolve()
             }
         }
 
+        if (m_load_balance_int >= 0 && m_nstep > 0 &&
+            ((m_regrid_int > 0 && m_nstep%m_regrid_int == 0) ||
+             (m_load_balance_int > 0 && m_nstep%m_load_balance_int == 0)))
+        {
+            LoadBalance(m_cur_time);
+        }
+
+        UpdateRegularisation();
+
         // Advance to time t + dt
         Advance();
         m_nstep++;
@@ -205,22 +214,17 @@ void incflo::MakeNewLevelFromScratch (int lev, Real time, const BoxArray& new_gr
     SetBoxArray(lev, new_grids);
     SetDistributionMap(lev, new_dmap);
 
-#ifdef AMREX_USE_EB
-    m_factory[lev] = makeEBFabFactory(geom[lev], grids[lev], dmap[lev],
-                                      {nghost_eb_basic(),
-                                       nghost_eb_volume(),
-                                       nghost_eb_full()},
-                                       EBSupport::full);
-#else
-    m_factory[lev].reset(new FArrayBoxFactory());
-#endif
+    m_factory[lev] = make_factory(lev, grids[lev], dmap[lev]);
+    m_workspace[lev].reset();
+    m_eta_faces[lev].clear();
+    reset_costs(lev, grids[lev], dmap[lev]);
 
     m_leveldata[lev].reset(new LevelData(grids[lev], dmap[lev], *m_factory[lev],
                                          m_ntrac, nghost_state(),
                                          m_advection_type,
                                          m_diff_type==DiffusionType::Implicit,
                                            use_tensor_correction,
-                                         m_advect_tracer));
+                                         m_advect_tracer, hasEBFlow()));
 
     m_t_new[lev] = time;
     m_t_old[lev] = time - 1.e200;
@@ -229,6 +233,10 @@ void incflo::MakeNewLevelFromScratch (int lev, Real time, const BoxArray& new_gr
         prob_init_fluid(lev);
     }
 
+    nodal_projector.reset();
+    m_p_nd_prev.clear();
+    m_p_nd_prev_valid = false;
+
 #ifdef AMREX_USE_EB
     macproj.reset(new Hydro::MacProjector(Geom(0,finest_level),
                       MLMG::Location::FaceCentroid,  // Location of mac_vec
@@ -286,12 +294,14 @@ incflo::writeNow()
     return write_now;
 }
 
+// The EB inflow state is only allocated when EB flow is enabled; without it
+// these return null pointers.
 Vector<MultiFab*> incflo::get_velocity_eb () noexcept
 {
     Vector<MultiFab*> r;
     r.reserve(finest_level+1);
     for (int lev = 0; lev <= finest_level; ++lev) {
-        r.push_back(&(m_leveldata[lev]->velocity_eb));
+        r.push_back(m_leveldata[lev]->velocity_eb.ok() ? &(m_leveldata[lev]->velocity_eb) : nullptr);
     }
     return r;
 }
@@ -301,7 +311,7 @@ Vector<MultiFab*> incflo::get_density_eb () noexcept
     Vector<MultiFab*> r;
     r.reserve(finest_level+1);
     for (int lev = 0; lev <= finest_level; ++lev) {
-        r.push_back(&(m_leveldata[lev]->density_eb));
+        r.push_back(m_leveldata[lev]->density_eb.ok() ? &(m_leveldata[lev]->density_eb) : nullptr);
     }
     return r;
 }
@@ -311,7 +321,7 @@ Vector<MultiFab*> incflo::get_tracer_eb () noexcept
     Vector<MultiFab*> r;
     r.reserve(finest_level+1);
     for (int lev = 0; lev <= finest_level; ++lev) {
-        r.push_back(&(m_leveldata[lev]->tracer_eb));
+        r.push_back(m_leveldata[lev]->tracer_eb.ok() ? &(m_leveldata[lev]->tracer_eb) : nullptr);
     }
     return r;
 }
@@ -627,3 +637,26 @@ void incflo::copy_from_old_to_new_tracer (int lev, IntVect const& ng)
                        m_leveldata[lev]->tracer_o, 0, 0, m_ntrac, ng);
     }
 }
+
+void incflo::swap_new_and_old_velocity ()
+{
+    for (int lev = 0; lev <= finest_level; ++lev) {
+        std::swap(m_leveldata[lev]->velocity, m_leveldata[lev]->velocity_o);
+    }
+}
+
+void incflo::swap_new_and_old_density ()
+{
+    for (int lev = 0; lev <= finest_level; ++lev) {
+        std::swap(m_leveldata[lev]->density, m_leveldata[lev]->density_o);
+    }
+}
+
+void incflo::swap_new_and_old_tracer ()
+{
+    if (m_ntrac > 0) {
+        for (int lev = 0; lev <= finest_level; ++lev) {
+            std::swap(m_leveldata[lev]->tracer, m_leveldata[lev]->tracer_o);
+        }
+    }
+}
@@ -29,9 +29,21 @@ void incflo::Advance()
                        << " with dt = " << m_dt << ".\n" << std::endl;
     }
 
-    copy_from_new_to_old_velocity();
-    copy_from_new_to_old_density();
-    copy_from_new_to_old_tracer();
+    // The predictor writes the new state from the old one wherever it updates it,
+    // so there the two can be swapped instead of copied. The constant density and
+    // unadvected tracers are never written, so their old values are copied since
+    // they are not set on regridded levels or on restart.
+    swap_new_and_old_velocity();
+    if (m_constant_density) {
+        copy_from_new_to_old_density();
+    } else {
+        swap_new_and_old_density();
+    }
+    if (m_advect_tracer) {
+        swap_new_and_old_tracer();
+    } else {
+        copy_from_new_to_old_tracer();
+    }
 
     int ng = nghost_state();
     for (int lev = 0; lev <= finest_level; ++lev) {
@@ -94,5 +106,7 @@ void incflo::Advance()
     {
         amrex::Print() << "Time per step " << end_step << std::endl;
     }
+
+    if (m_verbose > 1) PrintWorkspaceStats();
 }
 
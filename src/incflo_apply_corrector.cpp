@@ -76,79 +76,63 @@ void incflo::ApplyCorrector()
     }
 
     // *************************************************************************************
-    // Allocate space for the MAC velocities
+    // Get the MAC velocities, half-time density, forcing terms and viscosities
+    //    from the persistent workspace
     // *************************************************************************************
-    Vector<MultiFab> AMREX_D_DECL(u_mac(finest_level+1), v_mac(finest_level+1), w_mac(finest_level+1));
-    int ngmac = nghost_mac();
-
-    for (int lev = 0; lev <= finest_level; ++lev) {
-        AMREX_D_TERM(u_mac[lev].define(amrex::convert(grids[lev],IntVect::TheDimensionVector(0)), dmap[lev],
-                          1, ngmac, MFInfo(), Factory(lev));,
-                     v_mac[lev].define(amrex::convert(grids[lev],IntVect::TheDimensionVector(1)), dmap[lev],
-                          1, ngmac, MFInfo(), Factory(lev));,
-                     w_mac[lev].define(amrex::convert(grids[lev],IntVect::TheDimensionVector(2)), dmap[lev],
-                          1, ngmac, MFInfo(), Factory(lev)););
-        if (ngmac > 0) {
-            AMREX_D_TERM(u_mac[lev].setBndry(0.0);,
-                         v_mac[lev].setBndry(0.0);,
-                         w_mac[lev].setBndry(0.0););
+    AMREX_D_TERM(Vector<MultiFab*> u_mac = get_workspace(&Workspace::u_mac);,
+                 Vector<MultiFab*> v_mac = get_workspace(&Workspace::v_mac);,
+                 Vector<MultiFab*> w_mac = get_workspace(&Workspace::w_mac););
+    if (nghost_mac() > 0) {
+        for (int lev = 0; lev <= finest_level; ++lev) {
+            AMREX_D_TERM(u_mac[lev]->setBndry(0.0);,
+                         v_mac[lev]->setBndry(0.0);,
+                         w_mac[lev]->setBndry(0.0););
         }
     }
 
-    // *************************************************************************************
-    // Allocate space for half-time density
-    // *************************************************************************************
-    Vector<MultiFab> density_nph;
-    for (int lev = 0; lev <= finest_level; ++lev) {
-        density_nph.emplace_back(grids[lev], dmap[lev], 1, 0, MFInfo(), Factory(lev));
-    }
+    Vector<MultiFab*> density_nph = get_workspace(&Workspace::density_nph);
 
     // **********************************************************************************************
     // We only reach the corrector if advection_type == MOL which means we don't use the forces
     //    in constructing the advection term
+    // (tra_forces and tra_eta are empty if we don't advect tracers)
     // **********************************************************************************************
-    Vector<MultiFab> vel_forces, tra_forces;
-    Vector<MultiFab> vel_eta, tra_eta;
-    for (int lev = 0; lev <= finest_level; ++lev) {
-        vel_forces.emplace_back(grids[lev], dmap[lev], AMREX_SPACEDIM, nghost_force(),
-                                MFInfo(), Factory(lev));
-        if (m_advect_tracer) {
-            tra_forces.emplace_back(grids[lev], dmap[lev], m_ntrac, nghost_force(),
-                                    MFInfo(), Factory(lev));
-        }
-        vel_eta.emplace_back(grids[lev], dmap[lev], 1, 1, MFInfo(), Factory(lev));
-        if (m_advect_tracer) {
-            tra_eta.emplace_back(grids[lev], dmap[lev], m_ntrac, 1, MFInfo(), Factory(lev));
-        }
-    }
+    Vector<MultiFab*> vel_forces = get_workspace(&Workspace::vel_forces);
+    Vector<MultiFab*> tra_forces = get_workspace(&Workspace::tra_forces);
+
+    Vector<MultiFab*> vel_eta = get_workspace(&Workspace::vel_eta);
+    Vector<MultiFab*> tra_eta = get_workspace(&Workspace::tra_eta);
 
     // **********************************************************************************************
     // Compute the MAC-projected velocities at all levels
     // *************************************************************************************
     bool include_pressure_gradient = !(m_use_mac_phi_in_godunov);
-    compute_vel_forces(GetVecOfPtrs(vel_forces), get_velocity_new_const(),
+    compute_vel_forces(vel_forces, get_velocity_new_const(),
                        get_density_new_const(), get_tracer_new_const(), get_tracer_new_const(),
                        include_pressure_gradient);
     compute_MAC_projected_velocities(get_velocity_new_const(), get_density_new_const(),
-                                     AMREX_D_DECL(GetVecOfPtrs(u_mac), GetVecOfPtrs(v_mac),
-                                     GetVecOfPtrs(w_mac)), GetVecOfPtrs(vel_forces), new_time);
+                                     AMREX_D_DECL(u_mac, v_mac, w_mac), vel_forces, new_time);
     // **********************************************************************************************
     // Compute the explicit "new" advective terms R_u^(n+1,*), R_r^(n+1,*) and R_t^(n+1,*)
     // Note that "get_conv_tracer_new" returns div(rho u tracer)
     // *************************************************************************************
     compute_convective_term(get_conv_velocity_new(), get_conv_density_new(), get_conv_tracer_new(),
                             get_velocity_new_const(), get_density_new_const(), get_tracer_new_const(),
-                            AMREX_D_DECL(GetVecOfPtrs(u_mac), GetVecOfPtrs(v_mac),
-                            GetVecOfPtrs(w_mac)),
+                            AMREX_D_DECL(u_mac, v_mac, w_mac),
                             {}, {}, new_time);
 
     // *************************************************************************************
     // Compute viscosity / diffusive coefficients
     // *************************************************************************************
-    compute_viscosity(GetVecOfPtrs(vel_eta),
-                      get_density_new(), get_velocity_new(),
-                      new_time, 1);
-    compute_tracer_diff_coeff(GetVecOfPtrs(tra_eta),1);
+    // There is no vel_eta to fill with constant-coefficient diffusion operators,
+    // or with explicit diffusion and the fused divtau
+    if (!vel_eta.empty()) {
+        compute_viscosity(vel_eta,
+                          get_density_new(), get_velocity_new(),
+                          new_time, 1);
+    }
+    compute_tracer_diff_coeff(tra_eta, get_density_new(), get_velocity_new(),
+                              get_tracer_new(), 1);
 
     // Here we create divtau of the (n+1,*) state that was computed in the predictor;
     //      we use this laps only if DiffusionType::Explicit
@@ -168,15 +152,21 @@ void incflo::ApplyCorrector()
     // *************************************************************************************
     Real l_dt = m_dt;
     bool l_constant_density = m_constant_density;
+    bool l_fused_update = useFusedStateUpdate();
     int l_ntrac = (m_advect_tracer) ? m_ntrac : 0;
 
     // *************************************************************************************
     // Update density first
     // *************************************************************************************
-    if (l_constant_density)
+    if (l_fused_update)
+    {
+        // Density, tracer and velocity are updated together
+        update_state_corrector(density_nph, tra_forces);
+    }
+    else if (l_constant_density)
     {
         for (int lev = 0; lev <= finest_level; lev++)
-            MultiFab::Copy(density_nph[lev], m_leveldata[lev]->density_o, 0, 0, 1, 0);
+            MultiFab::Copy(*density_nph[lev], m_leveldata[lev]->density_o, 0, 0, 1, 0);
     } else {
         for (int lev = 0; lev <= finest_level; lev++)
         {
@@ -189,7 +179,7 @@ void incflo::ApplyCorrector()
                 Box const& bx = mfi.tilebox();
                 Array4<Real const> const& rho_o  = ld.density_o.const_array(mfi);
                 Array4<Real> const& rho_n        = ld.density.array(mfi);
-                Array4<Real> const& rho_nph      = density_nph[lev].array(mfi);
+                Array4<Real> const& rho_nph      = density_nph[lev]->array(mfi);
                 Array4<Real const> const& drdt_o = ld.conv_density_o.const_array(mfi);
                 Array4<Real const> const& drdt   = ld.conv_density.const_array(mfi);
 
@@ -209,15 +199,15 @@ void incflo::ApplyCorrector()
     // *************************************************************************************
     // Compute the tracer forcing terms (forcing for (rho s), not for s)
     // *************************************************************************************
-    if (m_advect_tracer)
-        compute_tra_forces(GetVecOfPtrs(tra_forces),  GetVecOfConstPtrs(density_nph));
+    if (m_advect_tracer && !l_fused_update)
+        compute_tra_forces(tra_forces,  GetVecOfConstPtrs(density_nph));
 
     // *************************************************************************************
     // Update the tracer next (note that dtdt already has rho in it)
     // (rho trac)^new = (rho trac)^old + dt * (
     //                   div(rho trac u) + div (mu grad trac) + rho * f_t
     // *************************************************************************************
-    if (m_advect_tracer)
+    if (m_advect_tracer && !l_fused_update)
     {
         for (int lev = 0; lev <= finest_level; lev++)
         {
@@ -234,7 +224,7 @@ void incflo::ApplyCorrector()
                 Array4<Real const> const& rho     = ld.density.const_array(mfi);
                 Array4<Real const> const& dtdt_o  = ld.conv_tracer_o.const_array(mfi);
                 Array4<Real const> const& dtdt    = ld.conv_tracer.const_array(mfi);
-                Array4<Real const> const& tra_f   = (l_ntrac > 0) ? tra_forces[lev].const_array(mfi)
+                Array4<Real const> const& tra_f   = (l_ntrac > 0) ? tra_forces[lev]->const_array(mfi)
                                                                 : Array4<Real const>{};
 
                 if (m_diff_type == DiffusionType::Explicit)
@@ -308,85 +298,88 @@ void incflo::ApplyCorrector()
         diffuse_scalar(get_tracer_new(), get_density_new(), GetVecOfConstPtrs(tra_eta), dt_diff);
     }
 
-    // *************************************************************************************
-    // Define the forcing terms to use in the final update (using half-time density)
-    // *************************************************************************************
-    compute_vel_forces(GetVecOfPtrs(vel_forces), get_velocity_new_const(),
-                       GetVecOfConstPtrs(density_nph),
-                       get_tracer_old_const(), get_tracer_new_const());
-
-    // *************************************************************************************
-    // Update velocity
-    // *************************************************************************************
-    for (int lev = 0; lev <= finest_level; ++lev)
+    if (!l_fused_update)
     {
-        auto& ld = *m_leveldata[lev];
+        // *************************************************************************************
+        // Define the forcing terms to use in the final update (using half-time density)
+        // *************************************************************************************
+        compute_vel_forces(vel_forces, get_velocity_new_const(),
+                           GetVecOfConstPtrs(density_nph),
+                           get_tracer_old_const(), get_tracer_new_const());
+
+        // *************************************************************************************
+        // Update velocity
+        // *************************************************************************************
+        for (int lev = 0; lev <= finest_level; ++lev)
+        {
+            auto& ld = *m_leveldata[lev];
 
 #ifdef _OPENMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
-        for (MFIter mfi(ld.velocity,TilingIfNotGPU()); mfi.isValid(); ++mfi)
-        {
-            Box const& bx = mfi.tilebox();
-            Array4<Real> const& vel = ld.velocity.array(mfi);
-            Array4<Real const> const& vel_o = ld.velocity_o.const_array(mfi);
-            Array4<Real const> const& dvdt = ld.conv_velocity.const_array(mfi);
-            Array4<Real const> const& dvdt_o = ld.conv_velocity_o.const_array(mfi);
-            Array4<Real const> const& vel_f = vel_forces[lev].const_array(mfi);
-
-            if (m_diff_type == DiffusionType::Explicit)
-            {
-                Array4<Real const> const& divtau_o = ld.divtau_o.const_array(mfi);
-                Array4<Real const> const& divtau   = ld.divtau.const_array(mfi);
-                amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-                {
-                    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
-                        vel(i,j,k,idim) = vel_o(i,j,k,idim) + l_dt * (
-                             0.5*(  dvdt_o(i,j,k,idim)+  dvdt(i,j,k,idim))
-                            +0.5*(divtau_o(i,j,k,idim)+divtau(i,j,k,idim))
-                            +        vel_f(i,j,k,idim) );
-                    }
-                });
-            }
-            else if (m_diff_type == DiffusionType::Crank_Nicolson)
-            {
-                Array4<Real const> const& divtau_o = ld.divtau_o.const_array(mfi);
-                amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-                {
-                    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
-                        vel(i,j,k,idim) = vel_o(i,j,k,idim) + l_dt * (
-                            0.5*(  dvdt_o(i,j,k,idim)+dvdt(i,j,k,idim))
-                           +0.5*(divtau_o(i,j,k,idim)                 )
-                           +        vel_f(i,j,k,idim) );
-                    }
-                });
-            }
-            else if (m_diff_type == DiffusionType::Implicit)
+            for (MFIter mfi(ld.velocity,TilingIfNotGPU()); mfi.isValid(); ++mfi)
             {
-                if (use_tensor_correction)
+                Box const& bx = mfi.tilebox();
+                Array4<Real> const& vel = ld.velocity.array(mfi);
+                Array4<Real const> const& vel_o = ld.velocity_o.const_array(mfi);
+                Array4<Real const> const& dvdt = ld.conv_velocity.const_array(mfi);
+                Array4<Real const> const& dvdt_o = ld.conv_velocity_o.const_array(mfi);
+                Array4<Real const> const& vel_f = vel_forces[lev]->const_array(mfi);
+
+                if (m_diff_type == DiffusionType::Explicit)
                 {
+                    Array4<Real const> const& divtau_o = ld.divtau_o.const_array(mfi);
                     Array4<Real const> const& divtau   = ld.divtau.const_array(mfi);
                     amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
                     {
-                        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
-                        {
-                            // Here divtau is the difference of tensor and scalar divtau!
+                        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
                             vel(i,j,k,idim) = vel_o(i,j,k,idim) + l_dt * (
-                                 0.5*(  dvdt_o(i,j,k,idim)+dvdt(i,j,k,idim))
-                                +        vel_f(i,j,k,idim) + divtau(i,j,k,idim));
+                                 0.5*(  dvdt_o(i,j,k,idim)+  dvdt(i,j,k,idim))
+                                +0.5*(divtau_o(i,j,k,idim)+divtau(i,j,k,idim))
+                                +        vel_f(i,j,k,idim) );
                         }
                     });
-                } else {
+                }
+                else if (m_diff_type == DiffusionType::Crank_Nicolson)
+                {
+                    Array4<Real const> const& divtau_o = ld.divtau_o.const_array(mfi);
                     amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
                     {
-                        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
-                        {
+                        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
                             vel(i,j,k,idim) = vel_o(i,j,k,idim) + l_dt * (
-                                 0.5*(  dvdt_o(i,j,k,idim)+dvdt(i,j,k,idim))
-                                +        vel_f(i,j,k,idim) );
+                                0.5*(  dvdt_o(i,j,k,idim)+dvdt(i,j,k,idim))
+                               +0.5*(divtau_o(i,j,k,idim)                 )
+                               +        vel_f(i,j,k,idim) );
                         }
                     });
                 }
+                else if (m_diff_type == DiffusionType::Implicit)
+                {
+                    if (use_tensor_correction)
+                    {
+                        Array4<Real const> const& divtau   = ld.divtau.const_array(mfi);
+                        amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                        {
+                            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
+                            {
+                                // Here divtau is the difference of tensor and scalar divtau!
+                                vel(i,j,k,idim) = vel_o(i,j,k,idim) + l_dt * (
+                                     0.5*(  dvdt_o(i,j,k,idim)+dvdt(i,j,k,idim))
+                                    +        vel_f(i,j,k,idim) + divtau(i,j,k,idim));
+                            }
+                        });
+                    } else {
+                        amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                        {
+                            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
+                            {
+                                vel(i,j,k,idim) = vel_o(i,j,k,idim) + l_dt * (
+                                     0.5*(  dvdt_o(i,j,k,idim)+dvdt(i,j,k,idim))
+                                    +        vel_f(i,j,k,idim) );
+                            }
+                        });
+                    }
+                }
             }
         }
     }
@@ -407,7 +400,11 @@ void incflo::ApplyCorrector()
         }
 
         Real dt_diff = (m_diff_type == DiffusionType::Implicit) ? m_dt : 0.5*m_dt;
-        diffuse_velocity(get_velocity_new(), get_density_new(), GetVecOfConstPtrs(vel_eta), dt_diff);
+        if (useNonlinearViscosity()) {
+            diffuse_velocity_nonlinear(get_velocity_new(), get_density_new(), vel_eta, new_time, dt_diff);
+        } else {
+            diffuse_velocity(get_velocity_new(), get_density_new(), GetVecOfConstPtrs(vel_eta), dt_diff);
+        }
     }
 
     // **********************************************************************************************
@@ -415,8 +412,7 @@ void incflo::ApplyCorrector()
     // Project velocity field, update pressure
     bool incremental_projection = false;
     ApplyProjection(GetVecOfConstPtrs(density_nph),
-                    AMREX_D_DECL(GetVecOfPtrs(u_mac), GetVecOfPtrs(v_mac),
-                    GetVecOfPtrs(w_mac)),new_time,m_dt,incremental_projection);
+                    AMREX_D_DECL(u_mac, v_mac, w_mac),new_time,m_dt,incremental_projection);
 
 #ifdef AMREX_USE_EB
     // **********************************************************************************************
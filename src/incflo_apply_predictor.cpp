@@ -74,53 +74,28 @@ void incflo::ApplyPredictor (bool incremental_projection)
     }
 
     // *************************************************************************************
-    // Allocate space for the MAC velocities
+    // Get the MAC velocities, half-time density, forcing terms and viscosities
+    //    from the persistent workspace
     // *************************************************************************************
-    Vector<MultiFab> u_mac(finest_level+1), v_mac(finest_level+1), w_mac(finest_level+1);
-    int ngmac = nghost_mac();
-
-    for (int lev = 0; lev <= finest_level; ++lev) {
-        AMREX_D_TERM(u_mac[lev].define(amrex::convert(grids[lev],IntVect::TheDimensionVector(0)), dmap[lev],
-                          1, ngmac, MFInfo(), Factory(lev));,
-                     v_mac[lev].define(amrex::convert(grids[lev],IntVect::TheDimensionVector(1)), dmap[lev],
-                          1, ngmac, MFInfo(), Factory(lev));,
-                     w_mac[lev].define(amrex::convert(grids[lev],IntVect::TheDimensionVector(2)), dmap[lev],
-                          1, ngmac, MFInfo(), Factory(lev)););
-        if (ngmac > 0) {
-            AMREX_D_TERM(u_mac[lev].setBndry(0.0);,
-                         v_mac[lev].setBndry(0.0);,
-                         w_mac[lev].setBndry(0.0););
+    AMREX_D_TERM(Vector<MultiFab*> u_mac = get_workspace(&Workspace::u_mac);,
+                 Vector<MultiFab*> v_mac = get_workspace(&Workspace::v_mac);,
+                 Vector<MultiFab*> w_mac = get_workspace(&Workspace::w_mac););
+    if (nghost_mac() > 0) {
+        for (int lev = 0; lev <= finest_level; ++lev) {
+            AMREX_D_TERM(u_mac[lev]->setBndry(0.0);,
+                         v_mac[lev]->setBndry(0.0);,
+                         w_mac[lev]->setBndry(0.0););
         }
     }
 
-    // *************************************************************************************
-    // Allocate space for half-time density
-    // *************************************************************************************
-    Vector<MultiFab> density_nph;
-    for (int lev = 0; lev <= finest_level; ++lev)
-        density_nph.emplace_back(grids[lev], dmap[lev], 1, 1, MFInfo(), Factory(lev));
-
-    // Forcing terms
-    Vector<MultiFab> vel_forces, tra_forces;
-
-    Vector<MultiFab> vel_eta, tra_eta;
+    Vector<MultiFab*> density_nph = get_workspace(&Workspace::density_nph);
 
-    // *************************************************************************************
-    // Allocate space for the forcing terms
-    // *************************************************************************************
-    for (int lev = 0; lev <= finest_level; ++lev) {
-        vel_forces.emplace_back(grids[lev], dmap[lev], AMREX_SPACEDIM, nghost_force(),
-                                MFInfo(), Factory(lev));
+    // Forcing terms (tra_forces and tra_eta are empty if we don't advect tracers)
+    Vector<MultiFab*> vel_forces = get_workspace(&Workspace::vel_forces);
+    Vector<MultiFab*> tra_forces = get_workspace(&Workspace::tra_forces);
 
-        if (m_advect_tracer) {
-            tra_forces.emplace_back(grids[lev], dmap[lev], m_ntrac, nghost_force(),
-                                    MFInfo(), Factory(lev));
-        }
-        vel_eta.emplace_back(grids[lev], dmap[lev], 1, 1, MFInfo(), Factory(lev));
-        if (m_advect_tracer) {
-            tra_eta.emplace_back(grids[lev], dmap[lev], m_ntrac, 1, MFInfo(), Factory(lev));
-        }
-    }
+    Vector<MultiFab*> vel_eta = get_workspace(&Workspace::vel_eta);
+    Vector<MultiFab*> tra_eta = get_workspace(&Workspace::tra_eta);
 
     // *************************************************************************************
     // We now define the forcing terms to use in the Godunov prediction inside the predictor
@@ -129,10 +104,15 @@ void incflo::ApplyPredictor (bool incremental_projection)
     // *************************************************************************************
     // Compute viscosity / diffusive coefficients
     // *************************************************************************************
-    compute_viscosity(GetVecOfPtrs(vel_eta),
-                      get_density_old(), get_velocity_old(),
-                      m_cur_time, 1);
-    compute_tracer_diff_coeff(GetVecOfPtrs(tra_eta),1);
+    // There is no vel_eta to fill with constant-coefficient diffusion operators,
+    // or with explicit diffusion and the fused divtau
+    if (!vel_eta.empty()) {
+        compute_viscosity(vel_eta,
+                          get_density_old(), get_velocity_old(),
+                          m_cur_time, 1);
+    }
+    compute_tracer_diff_coeff(tra_eta, get_density_old(), get_velocity_old(),
+                              get_tracer_old(), 1);
 
     // *************************************************************************************
     // Compute explicit viscous term
@@ -156,12 +136,12 @@ void incflo::ApplyPredictor (bool incremental_projection)
     // Compute the MAC-projected velocities at all levels
     // *************************************************************************************
     bool include_pressure_gradient = !(m_use_mac_phi_in_godunov);
-    compute_vel_forces(GetVecOfPtrs(vel_forces), get_velocity_old_const(),
-                       get_density_old_const(), get_tracer_old_const(), get_tracer_new_const(),
+    // The new tracer is not computed yet, so the old one stands for it
+    compute_vel_forces(vel_forces, get_velocity_old_const(),
+                       get_density_old_const(), get_tracer_old_const(), get_tracer_old_const(),
                        include_pressure_gradient);
     compute_MAC_projected_velocities(get_velocity_old_const(), get_density_old_const(),
-                                     AMREX_D_DECL(GetVecOfPtrs(u_mac), GetVecOfPtrs(v_mac),
-                                     GetVecOfPtrs(w_mac)), GetVecOfPtrs(vel_forces), m_cur_time);
+                                     AMREX_D_DECL(u_mac, v_mac, w_mac), vel_forces, m_cur_time);
 
     // *************************************************************************************
     // if (advection_type == "Godunov")
@@ -172,9 +152,8 @@ void incflo::ApplyPredictor (bool incremental_projection)
     // *************************************************************************************
     compute_convective_term(get_conv_velocity_old(), get_conv_density_old(), get_conv_tracer_old(),
                             get_velocity_old_const(), get_density_old_const(), get_tracer_old_const(),
-                            AMREX_D_DECL(GetVecOfPtrs(u_mac), GetVecOfPtrs(v_mac),
-                            GetVecOfPtrs(w_mac)),
-                            GetVecOfPtrs(vel_forces), GetVecOfPtrs(tra_forces),
+                            AMREX_D_DECL(u_mac, v_mac, w_mac),
+                            vel_forces, tra_forces,
                             m_cur_time);
 
     // *************************************************************************************
@@ -182,14 +161,20 @@ void incflo::ApplyPredictor (bool incremental_projection)
     // *************************************************************************************
     Real l_dt = m_dt;
     bool l_constant_density = m_constant_density;
+    bool l_fused_update = useFusedStateUpdate();
 
     // *************************************************************************************
     // Update density first
     // *************************************************************************************
-    if (l_constant_density)
+    if (l_fused_update)
+    {
+        // Density, tracer and velocity are updated together
+        update_state_predictor(density_nph, tra_forces);
+    }
+    else if (l_constant_density)
     {
         for (int lev = 0; lev <= finest_level; lev++)
-            MultiFab::Copy(density_nph[lev], m_leveldata[lev]->density_o, 0, 0, 1, 1);
+            MultiFab::Copy(*density_nph[lev], m_leveldata[lev]->density_o, 0, 0, 1, 1);
     } else {
         for (int lev = 0; lev <= finest_level; lev++)
         {
@@ -220,7 +205,7 @@ void incflo::ApplyPredictor (bool incremental_projection)
                 Box const& gbx = mfi.growntilebox(1);
                 Array4<Real  const> const& rho_old  = ld.density_o.const_array(mfi);
                 Array4<Real  const> const& rho_new  = ld.density.const_array(mfi);
-                Array4<Real>        const& rho_nph  = density_nph[lev].array(mfi);
+                Array4<Real>        const& rho_nph  = density_nph[lev]->array(mfi);
 
                 amrex::ParallelFor(gbx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
                 {
@@ -234,15 +219,15 @@ void incflo::ApplyPredictor (bool incremental_projection)
     // *************************************************************************************
     // Compute (or if Godunov, re-compute) the tracer forcing terms (forcing for (rho s), not for s)
     // *************************************************************************************
-    if (m_advect_tracer)
-       compute_tra_forces(GetVecOfPtrs(tra_forces), GetVecOfConstPtrs(density_nph));
+    if (m_advect_tracer && !l_fused_update)
+       compute_tra_forces(tra_forces, GetVecOfConstPtrs(density_nph));
 
     // *************************************************************************************
     // Update the tracer next
     // *************************************************************************************
     int l_ntrac = (m_advect_tracer) ? m_ntrac : 0;
 
-    if (m_advect_tracer)
+    if (m_advect_tracer && !l_fused_update)
     {
         for (int lev = 0; lev <= finest_level; lev++)
         {
@@ -258,7 +243,7 @@ void incflo::ApplyPredictor (bool incremental_projection)
                 Array4<Real> const& tra           = ld.tracer.array(mfi);
                 Array4<Real const> const& rho     = ld.density.const_array(mfi);
                 Array4<Real const> const& dtdt_o  = ld.conv_tracer_o.const_array(mfi);
-                Array4<Real const> const& tra_f   = (l_ntrac > 0) ? tra_forces[lev].const_array(mfi)
+                Array4<Real const> const& tra_f   = (l_ntrac > 0) ? tra_forces[lev]->const_array(mfi)
                                                                   : Array4<Real const>{};
 
                 if (m_diff_type == DiffusionType::Explicit)
@@ -328,75 +313,79 @@ void incflo::ApplyPredictor (bool incremental_projection)
 
     } // if (m_advect_tracer)
 
-    // *************************************************************************************
-    // Define (or if advection_type != "MOL", re-define) the forcing terms, without the viscous terms
-    //    and using the half-time density
-    // *************************************************************************************
-    compute_vel_forces(GetVecOfPtrs(vel_forces), get_velocity_old_const(),
-                       GetVecOfConstPtrs(density_nph),
-                       get_tracer_old_const(), get_tracer_new_const());
-
-
-    // *************************************************************************************
-    // Update the velocity
-    // *************************************************************************************
-    for (int lev = 0; lev <= finest_level; lev++)
+    if (!l_fused_update)
     {
-        auto& ld = *m_leveldata[lev];
+        // *************************************************************************************
+        // Define (or if advection_type != "MOL", re-define) the forcing terms, without the viscous terms
+        //    and using the half-time density
+        // *************************************************************************************
+        compute_vel_forces(vel_forces, get_velocity_old_const(),
+                           GetVecOfConstPtrs(density_nph),
+                           get_tracer_old_const(), get_tracer_new_const());
+
+
+        // *************************************************************************************
+        // Update the velocity
+        // *************************************************************************************
+        for (int lev = 0; lev <= finest_level; lev++)
+        {
+            auto& ld = *m_leveldata[lev];
 #ifdef _OPENMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
-        for (MFIter mfi(ld.velocity,TilingIfNotGPU()); mfi.isValid(); ++mfi)
-        {
-            Box const& bx = mfi.tilebox();
-            Array4<Real> const& vel = ld.velocity.array(mfi);
-            Array4<Real const> const& dvdt = ld.conv_velocity_o.const_array(mfi);
-            Array4<Real const> const& vel_f = vel_forces[lev].const_array(mfi);
+            for (MFIter mfi(ld.velocity,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+            {
+                Box const& bx = mfi.tilebox();
+                Array4<Real> const& vel = ld.velocity.array(mfi);
+                Array4<Real const> const& vel_o = ld.velocity_o.const_array(mfi);
+                Array4<Real const> const& dvdt = ld.conv_velocity_o.const_array(mfi);
+                Array4<Real const> const& vel_f = vel_forces[lev]->const_array(mfi);
 
-            if (m_diff_type == DiffusionType::Implicit) {
+                if (m_diff_type == DiffusionType::Implicit) {
 
-                if (use_tensor_correction)
+                    if (use_tensor_correction)
+                    {
+                        Array4<Real const> const& divtau_o = ld.divtau_o.const_array(mfi);
+                        amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                        {
+                            // Here divtau_o is the difference of tensor and scalar divtau_o!
+                            AMREX_D_TERM(vel(i,j,k,0) = vel_o(i,j,k,0) + l_dt*(dvdt(i,j,k,0)+vel_f(i,j,k,0)+divtau_o(i,j,k,0));,
+                                         vel(i,j,k,1) = vel_o(i,j,k,1) + l_dt*(dvdt(i,j,k,1)+vel_f(i,j,k,1)+divtau_o(i,j,k,1));,
+                                         vel(i,j,k,2) = vel_o(i,j,k,2) + l_dt*(dvdt(i,j,k,2)+vel_f(i,j,k,2)+divtau_o(i,j,k,2)););
+                        });
+                    } else {
+                        amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                        {
+                            AMREX_D_TERM(vel(i,j,k,0) = vel_o(i,j,k,0) + l_dt*(dvdt(i,j,k,0)+vel_f(i,j,k,0));,
+                                         vel(i,j,k,1) = vel_o(i,j,k,1) + l_dt*(dvdt(i,j,k,1)+vel_f(i,j,k,1));,
+                                         vel(i,j,k,2) = vel_o(i,j,k,2) + l_dt*(dvdt(i,j,k,2)+vel_f(i,j,k,2)););
+                        });
+                    }
+                }
+                else if (m_diff_type == DiffusionType::Crank_Nicolson)
                 {
+
                     Array4<Real const> const& divtau_o = ld.divtau_o.const_array(mfi);
                     amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
                     {
-                        // Here divtau_o is the difference of tensor and scalar divtau_o!
-                        AMREX_D_TERM(vel(i,j,k,0) += l_dt*(dvdt(i,j,k,0)+vel_f(i,j,k,0)+divtau_o(i,j,k,0));,
-                                     vel(i,j,k,1) += l_dt*(dvdt(i,j,k,1)+vel_f(i,j,k,1)+divtau_o(i,j,k,1));,
-                                     vel(i,j,k,2) += l_dt*(dvdt(i,j,k,2)+vel_f(i,j,k,2)+divtau_o(i,j,k,2)););
+                        AMREX_D_TERM(vel(i,j,k,0) = vel_o(i,j,k,0) + l_dt*(dvdt(i,j,k,0)+vel_f(i,j,k,0)+0.5*divtau_o(i,j,k,0));,
+                                     vel(i,j,k,1) = vel_o(i,j,k,1) + l_dt*(dvdt(i,j,k,1)+vel_f(i,j,k,1)+0.5*divtau_o(i,j,k,1));,
+                                     vel(i,j,k,2) = vel_o(i,j,k,2) + l_dt*(dvdt(i,j,k,2)+vel_f(i,j,k,2)+0.5*divtau_o(i,j,k,2)););
                     });
-                } else {
+                }
+                else if (m_diff_type == DiffusionType::Explicit)
+                {
+                    Array4<Real const> const& divtau_o = ld.divtau_o.const_array(mfi);
                     amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
                     {
-                        AMREX_D_TERM(vel(i,j,k,0) += l_dt*(dvdt(i,j,k,0)+vel_f(i,j,k,0));,
-                                     vel(i,j,k,1) += l_dt*(dvdt(i,j,k,1)+vel_f(i,j,k,1));,
-                                     vel(i,j,k,2) += l_dt*(dvdt(i,j,k,2)+vel_f(i,j,k,2)););
+                        AMREX_D_TERM(vel(i,j,k,0) = vel_o(i,j,k,0) + l_dt*(dvdt(i,j,k,0)+vel_f(i,j,k,0)+divtau_o(i,j,k,0));,
+                                     vel(i,j,k,1) = vel_o(i,j,k,1) + l_dt*(dvdt(i,j,k,1)+vel_f(i,j,k,1)+divtau_o(i,j,k,1));,
+                                     vel(i,j,k,2) = vel_o(i,j,k,2) + l_dt*(dvdt(i,j,k,2)+vel_f(i,j,k,2)+divtau_o(i,j,k,2)););
                     });
                 }
-            }
-            else if (m_diff_type == DiffusionType::Crank_Nicolson)
-            {
-
-                Array4<Real const> const& divtau_o = ld.divtau_o.const_array(mfi);
-                amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-                {
-                    AMREX_D_TERM(vel(i,j,k,0) += l_dt*(dvdt(i,j,k,0)+vel_f(i,j,k,0)+0.5*divtau_o(i,j,k,0));,
-                                 vel(i,j,k,1) += l_dt*(dvdt(i,j,k,1)+vel_f(i,j,k,1)+0.5*divtau_o(i,j,k,1));,
-                                 vel(i,j,k,2) += l_dt*(dvdt(i,j,k,2)+vel_f(i,j,k,2)+0.5*divtau_o(i,j,k,2)););
-                });
-            }
-            else if (m_diff_type == DiffusionType::Explicit)
-            {
-                Array4<Real const> const& divtau_o = ld.divtau_o.const_array(mfi);
-                amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-                {
-                    AMREX_D_TERM(vel(i,j,k,0) += l_dt*(dvdt(i,j,k,0)+vel_f(i,j,k,0)+divtau_o(i,j,k,0));,
-                                 vel(i,j,k,1) += l_dt*(dvdt(i,j,k,1)+vel_f(i,j,k,1)+divtau_o(i,j,k,1));,
-                                 vel(i,j,k,2) += l_dt*(dvdt(i,j,k,2)+vel_f(i,j,k,2)+divtau_o(i,j,k,2)););
-                });
-            }
-        } // mfi
-    } // lev
+            } // mfi
+        } // lev
+    }
 
     // *************************************************************************************
     // Solve diffusion equation for u* but using eta_old at old time
@@ -410,7 +399,11 @@ void incflo::ApplyPredictor (bool incremental_projection)
         }
 
         Real dt_diff = (m_diff_type == DiffusionType::Implicit) ? m_dt : 0.5*m_dt;
-        diffuse_velocity(get_velocity_new(), get_density_new(), GetVecOfConstPtrs(vel_eta), dt_diff);
+        if (useNonlinearViscosity()) {
+            diffuse_velocity_nonlinear(get_velocity_new(), get_density_new(), vel_eta, new_time, dt_diff);
+        } else {
+            diffuse_velocity(get_velocity_new(), get_density_new(), GetVecOfConstPtrs(vel_eta), dt_diff);
+        }
     }
 
     // **********************************************************************************************
@@ -419,8 +412,7 @@ void incflo::ApplyPredictor (bool incremental_projection)
     //
     // **********************************************************************************************
     ApplyProjection(GetVecOfConstPtrs(density_nph),
-                    AMREX_D_DECL(GetVecOfPtrs(u_mac), GetVecOfPtrs(v_mac),
-                    GetVecOfPtrs(w_mac)),new_time,m_dt,incremental_projection);
+                    AMREX_D_DECL(u_mac, v_mac, w_mac),new_time,m_dt,incremental_projection);
 
 #ifdef AMREX_USE_EB
     // **********************************************************************************************
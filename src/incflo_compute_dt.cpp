@@ -30,9 +30,17 @@ void incflo::ComputeDt (int initialization, bool explicit_diffusion)
     m_prev_prev_dt = m_prev_dt;
     m_prev_dt = m_dt;
 
-    Real conv_cfl = 0.0;
-    Real diff_cfl = 0.0;
-    Real forc_cfl = 0.0;
+    // The convective, diffusive and forcing limits of all levels are found in a
+    // single pass over the cells and a single MPI reduction. The forcing term is
+    // the one of compute_vel_forces_on_level (with the pressure gradient),
+    // evaluated on the fly.
+    ReduceOps<ReduceOpMax, ReduceOpMax, ReduceOpMax> reduce_op;
+    ReduceData<Real, Real, Real> reduce_data(reduce_op);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
+
+    GpuArray<Real,3> l_gravity{m_gravity[0],m_gravity[1],m_gravity[2]};
+    GpuArray<Real,3> l_gp0{m_gp0[0], m_gp0[1], m_gp0[2]};
+    const bool use_boussinesq = m_use_boussinesq;
 
     for (int lev = 0; lev <= finest_level; ++lev)
     {
@@ -41,152 +49,82 @@ void incflo::ComputeDt (int initialization, bool explicit_diffusion)
         MultiFab const& rho   = m_leveldata[lev]->density;
         MultiFab const& tra   = m_leveldata[lev]->tracer;
         MultiFab const& tra_o = m_leveldata[lev]->tracer_o;
+        MultiFab const& gp    = m_leveldata[lev]->gp;
 
-        Real conv_lev = 0.0;
-        Real diff_lev = 0.0;
-        Real forc_lev = 0.0;
-
-       // Make a temporary here to hold vel_forces
-       MultiFab vel_forces(grids[lev], dmap[lev], AMREX_SPACEDIM, 0);
-
-       compute_vel_forces_on_level (lev, vel_forces, vel, rho, tra_o, tra);
+        // V = 2 * max(eta/rho) * (1/dx^2 + 1/dy^2 +1/dz^2), with eta = mu
+        const Real diff_coef = explicit_diffusion
+            ? 2.0_rt * m_mu * (AMREX_D_TERM(dxinv[0]*dxinv[0], +dxinv[1]*dxinv[1], +dxinv[2]*dxinv[2]))
+            : 0.0_rt;
 
 #ifdef AMREX_USE_EB
-        if (!vel.isAllRegular()) {
-            auto const& flag = EBFactory(lev).getMultiEBCellFlagFab();
-            conv_lev = amrex::ReduceMax(vel, flag, 0,
-                       [=] AMREX_GPU_HOST_DEVICE (Box const& b,
-                                                  Array4<Real const> const& v,
-                                                  Array4<EBCellFlag const> const& f) -> Real
-                       {
-                           Real mx = -1.0;
-                           amrex::Loop(b, [=,&mx] (int i, int j, int k) noexcept
-                           {
-                               if (!f(i,j,k).isCovered()) {
-                                   mx = amrex::max(AMREX_D_DECL(amrex::Math::abs(v(i,j,k,0))*dxinv[0],
-                                                                amrex::Math::abs(v(i,j,k,1))*dxinv[1],
-                                                                amrex::Math::abs(v(i,j,k,2))*dxinv[2]), mx);
-                               }
-                           });
-                           return mx;
-                       });
-            if (explicit_diffusion) {
-                diff_lev = amrex::ReduceMax(rho, flag, 0,
-                           [=] AMREX_GPU_HOST_DEVICE (Box const& b,
-                                                      Array4<Real const> const& r,
-                                                      Array4<EBCellFlag const> const& f) -> Real
-                          {
-                              Real mx = -1.0;
-                              amrex::Loop(b, [=,&mx] (int i, int j, int k) noexcept
-                              {
-                                  if (!f(i,j,k).isCovered()) {
-                                      Real rho_inv = 1.0/r(i,j,k);
-                                      mx = amrex::max(rho_inv, mx);
-                                  }
-                              });
-                              return mx;
-                          });
-                diff_lev *= m_mu;
-            }
+        auto const& flags = EBFactory(lev).getMultiEBCellFlagFab();
+#endif
 
-            // Forcing term -- old way of computing
-            // const auto dxinv_finest = Geom(finest_level).InvCellSizeArray();
-            // forc_lev = std::abs(m_gravity[0] - std::abs(m_gp0[0])) * dxinv_finest[0]
-            //          + std::abs(m_gravity[1] - std::abs(m_gp0[1])) * dxinv_finest[1]
-            //          + std::abs(m_gravity[2] - std::abs(m_gp0[2])) * dxinv_finest[2];
-
-            // Forcing term -- new way of computing using "actual" forcing term
-            forc_lev = amrex::ReduceMax(vel_forces, flag, 0,
-                  [=] AMREX_GPU_HOST_DEVICE (Box const& b,
-                                             Array4<Real const> const& vf,
-                                             Array4<EBCellFlag const> const& f) -> Real
-                  {
-                      Real mx = -1.0;
-                      amrex::Loop(b, [=,&mx] (int i, int j, int k) noexcept
-                      {
-                          if (!f(i,j,k).isCovered()) {
-                              mx = amrex::max(AMREX_D_DECL(amrex::Math::abs(vf(i,j,k,0))*dxinv[0],
-                                                           amrex::Math::abs(vf(i,j,k,1))*dxinv[1],
-                                                           amrex::Math::abs(vf(i,j,k,2))*dxinv[2]), mx);
-                          }
-                      });
-                      return mx;
-                  });
-        } else
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
+        for (MFIter mfi(vel,TilingIfNotGPU()); mfi.isValid(); ++mfi)
         {
-            conv_lev = amrex::ReduceMax(vel, 0,
-                       [=] AMREX_GPU_HOST_DEVICE (Box const& b,
-                                                  Array4<Real const> const& v) -> Real
-                       {
-                           Real mx = -1.0;
-                           amrex::Loop(b, [=,&mx] (int i, int j, int k) noexcept
-                           {
-                               mx = amrex::max(AMREX_D_DECL(amrex::Math::abs(v(i,j,k,0))*dxinv[0],
-                                                            amrex::Math::abs(v(i,j,k,1))*dxinv[1],
-                                                            amrex::Math::abs(v(i,j,k,2))*dxinv[2]), mx);
-                           });
-                           return mx;
-                       });
-
-            if (explicit_diffusion) {
-                diff_lev = amrex::ReduceMax(rho, 0,
-                           [=] AMREX_GPU_HOST_DEVICE (Box const& b,
-                                                      Array4<Real const> const& r) -> Real
-                           {
-                               Real mx = -1.0;
-                               amrex::Loop(b, [=,&mx] (int i, int j, int k) noexcept
-                               {
-                                   Real rho_inv = 1.0/r(i,j,k);
-                                   mx = amrex::max(rho_inv, mx);
-                               });
-                               return mx;
-                           });
-                diff_lev *= m_mu;
-            }
-
-            // Forcing term -- old way of computing
-            // const auto dxinv_finest = Geom(finest_level).InvCellSizeArray();
-            // forc_lev = std::abs(m_gravity[0] - std::abs(m_gp0[0])) * dxinv_finest[0]
-            //          + std::abs(m_gravity[1] - std::abs(m_gp0[1])) * dxinv_finest[1]
-            //          + std::abs(m_gravity[2] - std::abs(m_gp0[2])) * dxinv_finest[2];
-
-            // Forcing term -- new way of computing using "actual" forcing term
-            forc_lev = amrex::ReduceMax(vel_forces, 0,
-                  [=] AMREX_GPU_HOST_DEVICE (Box const& b,
-                                             Array4<Real const> const& vf) -> Real
-                  {
-                      Real mx = -1.0;
-                      amrex::Loop(b, [=,&mx] (int i, int j, int k) noexcept
-                      {
-                          mx = amrex::max(AMREX_D_DECL(amrex::Math::abs(vf(i,j,k,0))*dxinv[0],
-                                                       amrex::Math::abs(vf(i,j,k,1))*dxinv[1],
-                                                       amrex::Math::abs(vf(i,j,k,2))*dxinv[2]), mx);
-                      });
-                      return mx;
-                  });
+            Box const& bx = mfi.tilebox();
+#ifdef AMREX_USE_EB
+            EBCellFlagFab const& flagfab = flags[mfi];
+            FabType typ = flagfab.getType(bx);
+            if (typ == FabType::covered) continue;
+            const bool has_covered = (typ != FabType::regular);
+            Array4<EBCellFlag const> const& flag = flagfab.const_array();
+#endif
+            Array4<Real const> const& v     = vel.const_array(mfi);
+            Array4<Real const> const& r     = rho.const_array(mfi);
+            Array4<Real const> const& gradp = gp.const_array(mfi);
+            Array4<Real const> const& tra_n = tra.const_array(mfi);
+            Array4<Real const> const& tra_p = tra_o.const_array(mfi);
+
+            reduce_op.eval(bx, reduce_data,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
+            {
+#ifdef AMREX_USE_EB
+                if (has_covered && flag(i,j,k).isCovered()) {
+                    return {0.0_rt, 0.0_rt, 0.0_rt};
+                }
+#endif
+                Real rhoinv = 1.0_rt/r(i,j,k);
+
+                Real conv = amrex::max(AMREX_D_DECL(amrex::Math::abs(v(i,j,k,0))*dxinv[0],
+                                                    amrex::Math::abs(v(i,j,k,1))*dxinv[1],
+                                                    amrex::Math::abs(v(i,j,k,2))*dxinv[2]));
+
+                Real diff = diff_coef * rhoinv;
+
+                Real forc = 0.0_rt;
+                if (use_boussinesq) {
+                    // Buoyancy from the first tracer rather than the density
+                    Real ft = 0.5_rt * (tra_p(i,j,k,0) + tra_n(i,j,k,0));
+                    for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                        Real f = -gradp(i,j,k,d)*rhoinv + l_gravity[d] * ft;
+                        forc = amrex::max(forc, amrex::Math::abs(f)*dxinv[d]);
+                    }
+                } else {
+                    for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                        Real f = -(gradp(i,j,k,d)+l_gp0[d])*rhoinv + l_gravity[d];
+                        forc = amrex::max(forc, amrex::Math::abs(f)*dxinv[d]);
+                    }
+                }
+
+                return {conv, diff, forc};
+            });
         }
-
-        forc_cfl = std::max(forc_cfl, forc_lev);
-        conv_cfl = std::max(conv_cfl, conv_lev);
-        diff_cfl = std::max(diff_cfl, diff_lev*2.0_rt*(dxinv[0]*dxinv[0]+dxinv[1]*dxinv[1]+
-                                                       dxinv[2]*dxinv[2]));
     }
 
-    Real cd_cfl;
-    if (explicit_diffusion) {
-        ParallelAllReduce::Max<Real>({conv_cfl,diff_cfl},
-                                     ParallelContext::CommunicatorSub());
-        cd_cfl = conv_cfl + diff_cfl;
-    } else {
-        ParallelAllReduce::Max<Real>(conv_cfl,
-                                     ParallelContext::CommunicatorSub());
-        cd_cfl = conv_cfl;
-    }
+    ReduceTuple hv = reduce_data.value();
+    Real conv_cfl = amrex::max(amrex::get<0>(hv), 0.0_rt);
+    Real diff_cfl = amrex::max(amrex::get<1>(hv), 0.0_rt);
+    Real forc_cfl = amrex::max(amrex::get<2>(hv), 0.0_rt);
 
-    ParallelAllReduce::Max<Real>(forc_cfl,
+    ParallelAllReduce::Max<Real>({conv_cfl, diff_cfl, forc_cfl},
                                  ParallelContext::CommunicatorSub());
 
+    Real cd_cfl = conv_cfl + diff_cfl;
+
     // Combined CFL conditioner
     Real comb_cfl = cd_cfl + std::sqrt(cd_cfl*cd_cfl + 4.0 * forc_cfl);
 
@@ -223,16 +161,48 @@ void incflo::ComputeDt (int initialization, bool explicit_diffusion)
         dt_new = 0.5 * m_dt;
     }
 
-    // Don't let the timestep grow by more than 10% per step
-    // unless the previous time step was unduly shrunk to match m_plot_per_exact
-    Real allowed_change_factor = 1.1;
-    if( (m_dt > 0.0) && !(m_plot_per_exact > 0 && m_last_plt == m_nstep && m_nstep > 0) )
+    // The previous time step may have been unduly shrunk to match m_plot_per_exact
+    Real dt_ref = m_prev_dt;
+    if (m_plot_per_exact > 0 && m_last_plt == m_nstep && m_nstep > 0)
+    {
+        dt_ref = amrex::max(m_prev_dt, m_prev_prev_dt);
+    }
+
+    if (m_dt_controller == DtController::pi && m_dt > 0.0 && !initialization && comb_cfl > eps)
     {
-        dt_new = amrex::min(dt_new, allowed_change_factor * m_prev_dt);
+        // r > 1 if the last dt was too large for the current CFL limit
+        Real dt_cfl = dt_new;
+        Real ratio = dt_ref / (m_dt_controller_safety * dt_cfl);
+        Real ratio_prev = (m_dt_ratio_prev > 0.0) ? m_dt_ratio_prev : ratio;
+        m_dt_ratio_prev = ratio;
+
+        Real factor = std::pow(ratio, -m_dt_controller_ki)
+                    * std::pow(ratio_prev/ratio, m_dt_controller_kp);
+
+        // Solver cost: back off if the velocity solve is getting expensive
+        if (m_dt_controller_target_iters > 0)
+        {
+            int iters = lastVelocitySolveIters();
+            if (iters > m_dt_controller_target_iters) {
+                factor = amrex::min(factor, std::pow(Real(m_dt_controller_target_iters)/Real(iters),
+                                                     m_dt_controller_ki));
+            }
+        }
+
+        factor = amrex::max(m_dt_max_shrink, amrex::min(m_dt_max_growth, factor));
+
+        // The CFL limit itself is never exceeded
+        dt_new = amrex::min(factor * dt_ref, dt_cfl);
+
+        if (m_verbose > 1) {
+            amrex::Print() << "  dt controller: CFL ratio " << ratio
+                           << ", factor " << factor << std::endl;
+        }
     }
-    else if ( (m_dt > 0.0) && (m_plot_per_exact > 0 && m_last_plt == m_nstep && m_nstep > 0) )
+    else if (m_dt > 0.0)
     {
-        dt_new = amrex::min( dt_new, allowed_change_factor * amrex::max(m_prev_dt, m_prev_prev_dt) );
+        // Don't let the timestep grow by more than dt_max_growth per step
+        dt_new = amrex::min(dt_new, m_dt_max_growth * dt_ref);
     }
 
     // Don't overshoot specified plot times
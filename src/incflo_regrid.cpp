@@ -1,5 +1,12 @@
 #include <incflo.H>
 
+#ifdef AMREX_USE_EB
+#include <AMReX_EB2.H>
+#endif
+
+#include <algorithm>
+#include <numeric>
+
 using namespace amrex;
 
 // Make a new level using provided BoxArray and DistributionMapping and
@@ -16,35 +23,35 @@ void incflo::MakeNewLevelFromCoarse (int lev,
         amrex::Print() << "Making new level " << lev << " from coarse" << std::endl;
     }
 
-#ifdef AMREX_USE_EB
-    std::unique_ptr<FabFactory<FArrayBox> > new_fact = makeEBFabFactory(geom[lev], ba, dm,
-                                                                        {nghost_eb_basic(),
-                                                                         nghost_eb_volume(),
-                                                                         nghost_eb_full()},
-                                                                        EBSupport::full);
-#else
-    std::unique_ptr<FabFactory<FArrayBox> > new_fact(new FArrayBoxFactory());
-#endif
+    std::unique_ptr<FabFactory<FArrayBox> > new_fact = make_factory(lev, ba, dm);
     std::unique_ptr<LevelData> new_leveldata
         (new LevelData(ba, dm, *new_fact, m_ntrac, nghost_state(),
                        m_advection_type,
                        m_diff_type==DiffusionType::Implicit,
                        use_tensor_correction,
-                       m_advect_tracer));
+                       m_advect_tracer, hasEBFlow()));
     fillcoarsepatch_velocity(lev, time, new_leveldata->velocity, 0);
     fillcoarsepatch_density(lev, time, new_leveldata->density, 0);
     if (m_ntrac > 0) {
         fillcoarsepatch_tracer(lev, time, new_leveldata->tracer, 0);
     }
     fillcoarsepatch_gradp(lev, time, new_leveldata->gp, 0);
-    new_leveldata->p_nd.setVal(0.0);
-    new_leveldata->p_cc.setVal(0.0);
+    fillcoarsepatch_mac_phi(lev, time, new_leveldata->mac_phi, 1);
+    fillcoarsepatch_p_cc(lev, time, new_leveldata->p_cc, 0);
+    fillcoarsepatch_p_nd(lev, new_leveldata->p_nd);
 
     m_leveldata[lev] = std::move(new_leveldata);
     m_factory[lev] = std::move(new_fact);
+    m_workspace[lev].reset();
+    m_eta_faces[lev].clear();
+    reset_costs(lev, ba, dm);
+
+    // The diffusion operators are kept; they are rebuilt on their next use
+    // only if the grids they were defined on have changed.
 
-    m_diffusion_tensor_op.reset();
-    m_diffusion_scalar_op.reset();
+    nodal_projector.reset();
+    m_p_nd_prev.clear();
+    m_p_nd_prev_valid = false;
 
 #ifdef AMREX_USE_EB
     macproj.reset(new Hydro::MacProjector(Geom(0,finest_level),
@@ -68,35 +75,35 @@ void incflo::RemakeLevel (int lev, Real time, const BoxArray& ba,
         amrex::Print() << "Remaking level " << lev << std::endl;
     }
 
-#ifdef AMREX_USE_EB
-    std::unique_ptr<FabFactory<FArrayBox> > new_fact = makeEBFabFactory(geom[lev], ba, dm,
-                                                                        {nghost_eb_basic(),
-                                                                         nghost_eb_volume(),
-                                                                         nghost_eb_full()},
-                                                                        EBSupport::full);
-#else
-    std::unique_ptr<FabFactory<FArrayBox> > new_fact(new FArrayBoxFactory());
-#endif
+    std::unique_ptr<FabFactory<FArrayBox> > new_fact = make_factory(lev, ba, dm);
     std::unique_ptr<LevelData> new_leveldata
         (new LevelData(ba, dm, *new_fact, m_ntrac, nghost_state(),
                        m_advection_type,
                        m_diff_type==DiffusionType::Implicit,
                        use_tensor_correction,
-                       m_advect_tracer));
+                       m_advect_tracer, hasEBFlow()));
     fillpatch_velocity(lev, time, new_leveldata->velocity, 0);
     fillpatch_density(lev, time, new_leveldata->density, 0);
     if (m_ntrac > 0) {
         fillpatch_tracer(lev, time, new_leveldata->tracer, 0);
     }
     fillpatch_gradp(lev, time, new_leveldata->gp, 0);
-    new_leveldata->p_nd.setVal(0.0);
-    new_leveldata->p_cc.setVal(0.0);
+    fillpatch_mac_phi(lev, time, new_leveldata->mac_phi, 1);
+    fillpatch_p_cc(lev, time, new_leveldata->p_cc, 0);
+    fillpatch_p_nd(lev, new_leveldata->p_nd);
 
     m_leveldata[lev] = std::move(new_leveldata);
     m_factory[lev] = std::move(new_fact);
+    m_workspace[lev].reset();
+    m_eta_faces[lev].clear();
+    reset_costs(lev, ba, dm);
+
+    // The diffusion operators are kept; they are rebuilt on their next use
+    // only if the grids they were defined on have changed.
 
-    m_diffusion_tensor_op.reset();
-    m_diffusion_scalar_op.reset();
+    nodal_projector.reset();
+    m_p_nd_prev.clear();
+    m_p_nd_prev_valid = false;
 
 #ifdef AMREX_USE_EB
     macproj.reset(new Hydro::MacProjector(Geom(0,finest_level),
@@ -115,7 +122,191 @@ void incflo::ClearLevel (int lev)
     BL_PROFILE("incflo::ClearLevel()");
     m_leveldata[lev].reset();
     m_factory[lev].reset();
-    m_diffusion_tensor_op.reset();
-    m_diffusion_scalar_op.reset();
+    m_workspace[lev].reset();
+    m_eta_faces[lev].clear();
+    m_costs[lev].reset();
     macproj.reset();
+    nodal_projector.reset();
+    m_p_nd_prev.clear();
+    m_p_nd_prev_valid = false;
+}
+
+// Redistribute the grids of each level with KnapSack or SFC, weighting each grid
+// by the wall time measured on it since its level was last (re)distributed.
+// Levels without measurements, e.g. those just rebuilt by a regrid, are left alone.
+void incflo::LoadBalance (Real time)
+{
+    BL_PROFILE("incflo::LoadBalance()");
+
+    const int nprocs = ParallelDescriptor::NProcs();
+
+    // Ratio of the average to the maximum load of the ranks
+    auto efficiency = [nprocs] (Vector<Real> const& rcost, DistributionMapping const& dm) -> Real
+    {
+        Vector<Real> load(nprocs, 0.0);
+        for (int i = 0; i < static_cast<int>(rcost.size()); ++i) {
+            load[dm[i]] += rcost[i];
+        }
+        Real max_load = *std::max_element(load.begin(), load.end());
+        Real avg_load = std::accumulate(load.begin(), load.end(), Real(0.0)) / nprocs;
+        return (max_load > 0.0) ? avg_load / max_load : Real(1.0);
+    };
+
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        if (!m_costs[lev]) continue;
+
+        Vector<Real> rcost(grids[lev].size(), 0.0);
+        for (int i : m_costs[lev]->IndexArray()) {
+            rcost[i] = (*m_costs[lev])[i];
+        }
+        ParallelDescriptor::ReduceRealSum(rcost.data(), rcost.size());
+
+        if (std::accumulate(rcost.begin(), rcost.end(), Real(0.0)) <= 0.0) continue;
+
+        DistributionMapping new_dm = (m_load_balance_type == "SFC")
+            ? DistributionMapping::makeSFC(rcost, grids[lev])
+            : DistributionMapping::makeKnapSack(rcost, m_knapsack_nmax);
+
+        Real current_efficiency  = efficiency(rcost, dmap[lev]);
+        Real proposed_efficiency = efficiency(rcost, new_dm);
+
+        if (m_verbose > 0) {
+            amrex::Print() << "Load balancing level " << lev << " with " << m_load_balance_type
+                           << ": efficiency " << current_efficiency
+                           << " -> " << proposed_efficiency << std::endl;
+        }
+
+        if (proposed_efficiency > current_efficiency && new_dm != dmap[lev])
+        {
+            RemakeLevel(lev, time, grids[lev], new_dm);
+            SetDistributionMap(lev, new_dm);
+        }
+        else
+        {
+            reset_costs(lev, grids[lev], dmap[lev]);
+        }
+    }
+}
+
+// Distribute new grids. Before any runtime cost has been measured on them, EB grids
+// are weighted by their cell types: covered cells cost nothing, regular cells 1
+// and cut cells incflo.eb_cut_cell_weight.
+DistributionMapping
+incflo::MakeDistributionMap (int lev, BoxArray const& ba)
+{
+#ifdef AMREX_USE_EB
+    if (m_eb_cut_cell_weight > 0.0)
+    {
+        BL_PROFILE("incflo::MakeDistributionMap()");
+
+        FabArray<EBCellFlagFab> flags(ba, DistributionMapping(ba), 1, 0);
+        EB2::IndexSpace::top().getLevel(Geom(lev)).fillEBCellFlag(flags, Geom(lev));
+
+        const Real cut_weight = m_eb_cut_cell_weight;
+        Vector<Real> rcost(ba.size(), 0.0);
+        for (MFIter mfi(flags); mfi.isValid(); ++mfi)
+        {
+            Box const& bx = mfi.validbox();
+            EBCellFlagFab const& flagfab = flags[mfi];
+            FabType typ = flagfab.getType(bx);
+            if (typ == FabType::regular)
+            {
+                rcost[mfi.index()] = static_cast<Real>(bx.numPts());
+            }
+            else if (typ != FabType::covered)
+            {
+                Array4<EBCellFlag const> const& flag = flagfab.const_array();
+                ReduceOps<ReduceOpSum> reduce_op;
+                ReduceData<Real> reduce_data(reduce_op);
+                using ReduceTuple = typename decltype(reduce_data)::Type;
+                reduce_op.eval(bx, reduce_data,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
+                {
+                    if (flag(i,j,k).isCovered()) {
+                        return {0.0};
+                    } else if (flag(i,j,k).isRegular()) {
+                        return {1.0};
+                    } else {
+                        return {cut_weight};
+                    }
+                });
+                rcost[mfi.index()] = amrex::get<0>(reduce_data.value());
+            }
+        }
+        ParallelDescriptor::ReduceRealSum(rcost.data(), rcost.size());
+
+        if (std::accumulate(rcost.begin(), rcost.end(), Real(0.0)) > 0.0)
+        {
+            return (m_load_balance_type == "SFC")
+                ? DistributionMapping::makeSFC(rcost, ba)
+                : DistributionMapping::makeKnapSack(rcost, m_knapsack_nmax);
+        }
+    }
+#endif
+    return AmrCore::MakeDistributionMap(lev, ba);
+}
+
+void incflo::reset_costs (int lev, BoxArray const& ba, DistributionMapping const& dm)
+{
+    if (collect_costs()) {
+        m_costs[lev].reset(new LayoutData<Real>(ba, dm));
+        for (int i : m_costs[lev]->IndexArray()) {
+            (*m_costs[lev])[i] = 0.0;
+        }
+    }
+}
+
+// Add the cost of the tile of mfi to the cost of its grid. On CPUs a tile runs to
+// completion in its thread, so this is the wall time elapsed since strt_time. On
+// GPUs the kernels are asynchronous and timing them would need a stream
+// synchronisation per tile, so the number of cells of the tile is used instead.
+void incflo::add_cost (int lev, MFIter const& mfi, Real strt_time)
+{
+#ifdef AMREX_USE_GPU
+    amrex::ignore_unused(strt_time);
+    Real wt = static_cast<Real>(mfi.tilebox().numPts());
+#else
+    Real wt = ParallelDescriptor::second() - strt_time;
+#endif
+    HostDevice::Atomic::Add(&(*m_costs[lev])[mfi.index()], wt);
+}
+
+// Make the FabFactory for level lev on the given grids. With EB, factories are
+// cached by BoxArray and DistributionMapping: cloning a cached factory shares
+// its EB data instead of recomputing it from the EB2 index space.
+std::unique_ptr<FabFactory<FArrayBox> >
+incflo::make_factory (int lev, BoxArray const& ba, DistributionMapping const& dm)
+{
+#ifdef AMREX_USE_EB
+    BL_PROFILE("incflo::make_factory()");
+
+    auto& cache = m_factory_cache[lev];
+    for (auto const& entry : cache) {
+        if (entry.ba == ba && entry.dm == dm) {
+            if (m_verbose > 1) {
+                amrex::Print() << "Reusing EB factory on level " << lev << std::endl;
+            }
+            return std::unique_ptr<FabFactory<FArrayBox> >(entry.factory->clone());
+        }
+    }
+
+    std::unique_ptr<FabFactory<FArrayBox> > new_fact = makeEBFabFactory(geom[lev], ba, dm,
+                                                                        {nghost_eb_basic(),
+                                                                         nghost_eb_volume(),
+                                                                         nghost_eb_full()},
+                                                                        EBSupport::full);
+    if (m_factory_cache_size > 0)
+    {
+        if (static_cast<int>(cache.size()) >= m_factory_cache_size) {
+            cache.erase(cache.begin());
+        }
+        cache.push_back(FactoryCacheEntry{ba, dm,
+                        std::unique_ptr<FabFactory<FArrayBox> >(new_fact->clone())});
+    }
+    return new_fact;
+#else
+    amrex::ignore_unused(lev, ba, dm);
+    return std::unique_ptr<FabFactory<FArrayBox> >(new FArrayBoxFactory());
+#endif
 }
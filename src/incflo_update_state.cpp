@@ -0,0 +1,323 @@
+#include <incflo.H>
+
+using namespace amrex;
+
+//
+// Explicit updates of the predictor and corrector done in one pass over each tile.
+//
+// Without the Boussinesq approximation the velocity forcing
+//
+//      vel_f = g - grad(p + p0) / rho^nph
+//
+// does not depend on the new tracer, so rho, (rho s) and u can be advanced
+// together before the tracer diffusion solve. The forcing is evaluated in the
+// kernel rather than stored in vel_forces. The half-time density is only swept
+// separately when the tracer forcing, which is computed from it, is needed.
+//
+
+void incflo::update_state_predictor (Vector<MultiFab*> const& density_nph,
+                                     Vector<MultiFab*> const& tra_forces)
+{
+    BL_PROFILE("incflo::update_state_predictor");
+
+    Real l_dt = m_dt;
+    bool l_constant_density = m_constant_density;
+    int l_ntrac = (m_advect_tracer) ? m_ntrac : 0;
+    DiffusionType l_diff_type = m_diff_type;
+    bool l_tensor_correction = use_tensor_correction;
+
+    GpuArray<Real,3> l_gravity{m_gravity[0],m_gravity[1],m_gravity[2]};
+    GpuArray<Real,3> l_gp0{m_gp0[0], m_gp0[1], m_gp0[2]};
+
+    const bool need_laps_o   = (l_ntrac > 0) && (l_diff_type != DiffusionType::Implicit);
+    const bool need_divtau_o = (l_diff_type != DiffusionType::Implicit) || l_tensor_correction;
+
+    // *************************************************************************************
+    // Half-time density for the tracer forcing terms
+    // *************************************************************************************
+    if (l_constant_density)
+    {
+        for (int lev = 0; lev <= finest_level; lev++)
+            MultiFab::Copy(*density_nph[lev], m_leveldata[lev]->density_o, 0, 0, 1, 1);
+    }
+    else if (m_advect_tracer)
+    {
+        for (int lev = 0; lev <= finest_level; lev++)
+        {
+            auto& ld = *m_leveldata[lev];
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+            for (MFIter mfi(ld.velocity,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+            {
+                Box const& bx = mfi.tilebox();
+                Array4<Real const> const& rho_o   = ld.density_o.const_array(mfi);
+                Array4<Real const> const& drdt_o  = ld.conv_density_o.const_array(mfi);
+                Array4<Real>       const& rho_nph = density_nph[lev]->array(mfi);
+
+                amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                {
+                    const Real rho_old = rho_o(i,j,k);
+                    Real rho_new = rho_old + l_dt * drdt_o(i,j,k);
+                    rho_nph(i,j,k) = 0.5 * (rho_old + rho_new);
+                });
+            } // mfi
+        } // lev
+    }
+
+    if (m_advect_tracer)
+        compute_tra_forces(tra_forces, GetVecOfConstPtrs(density_nph));
+
+    // *************************************************************************************
+    // Update rho, (rho s) and u
+    // *************************************************************************************
+    for (int lev = 0; lev <= finest_level; lev++)
+    {
+        auto& ld = *m_leveldata[lev];
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(ld.velocity,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            Box const& bx = mfi.tilebox();
+            Array4<Real const> const& rho_o    = ld.density_o.const_array(mfi);
+            Array4<Real>       const& rho      = ld.density.array(mfi);
+            Array4<Real const> const& drdt_o   = ld.conv_density_o.const_array(mfi);
+
+            Array4<Real const> const& tra_o    = (l_ntrac > 0) ? ld.tracer_o.const_array(mfi)
+                                                               : Array4<Real const>{};
+            Array4<Real>       const& tra      = (l_ntrac > 0) ? ld.tracer.array(mfi)
+                                                               : Array4<Real>{};
+            Array4<Real const> const& dtdt_o   = (l_ntrac > 0) ? ld.conv_tracer_o.const_array(mfi)
+                                                               : Array4<Real const>{};
+            Array4<Real const> const& tra_f    = (l_ntrac > 0) ? tra_forces[lev]->const_array(mfi)
+                                                               : Array4<Real const>{};
+            Array4<Real const> const& laps_o   = (need_laps_o) ? ld.laps_o.const_array(mfi)
+                                                               : Array4<Real const>{};
+
+            Array4<Real>       const& vel      = ld.velocity.array(mfi);
+            Array4<Real const> const& vel_o    = ld.velocity_o.const_array(mfi);
+            Array4<Real const> const& dvdt_o   = ld.conv_velocity_o.const_array(mfi);
+            Array4<Real const> const& gradp    = ld.gp.const_array(mfi);
+            Array4<Real const> const& divtau_o = (need_divtau_o) ? ld.divtau_o.const_array(mfi)
+                                                                 : Array4<Real const>{};
+
+            amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                const Real rho_old = rho_o(i,j,k);
+                Real rho_new = rho_old;
+                Real rho_nph = rho_old;
+                if (!l_constant_density)
+                {
+                    rho_new = rho_old + l_dt * drdt_o(i,j,k);
+                    rho_nph = 0.5 * (rho_old + rho_new);
+                    rho(i,j,k) = rho_new;
+                }
+
+                // (rho trac)^new = (rho trac)^old + dt * (
+                //                   div(rho trac u) + div (mu grad trac) + rho * f_t
+                for (int n = 0; n < l_ntrac; ++n)
+                {
+                    Real rhs = dtdt_o(i,j,k,n) + tra_f(i,j,k,n);
+                    if (l_diff_type == DiffusionType::Explicit) {
+                        rhs += laps_o(i,j,k,n);
+                    } else if (l_diff_type == DiffusionType::Crank_Nicolson) {
+                        rhs += 0.5 * laps_o(i,j,k,n);
+                    }
+                    tra(i,j,k,n) = (rho_old*tra_o(i,j,k,n) + l_dt * rhs) / rho_new;
+                }
+
+                // With the tensor correction divtau_o is the difference of
+                // tensor and scalar divtau_o
+                Real rhoinv = 1.0/rho_nph;
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
+                {
+                    Real vel_f = -(gradp(i,j,k,idim)+l_gp0[idim])*rhoinv + l_gravity[idim];
+                    Real rhs = dvdt_o(i,j,k,idim) + vel_f;
+                    if (l_diff_type == DiffusionType::Crank_Nicolson) {
+                        rhs += 0.5 * divtau_o(i,j,k,idim);
+                    } else if (l_diff_type == DiffusionType::Explicit || l_tensor_correction) {
+                        rhs += divtau_o(i,j,k,idim);
+                    }
+                    vel(i,j,k,idim) = vel_o(i,j,k,idim) + l_dt * rhs;
+                }
+            });
+        } // mfi
+
+        if (!l_constant_density)
+        {
+            // Fill ghost cells of the new density field so that we can define density_nph
+            //      on the valid region grown by 1 (we will need this for ccproj)
+            int ng = 1;
+            fillpatch_density(lev, m_t_new[lev], ld.density, ng);
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+            for (MFIter mfi(ld.velocity,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+            {
+                Box const& gbx = mfi.growntilebox(1);
+                Array4<Real const> const& rho_old = ld.density_o.const_array(mfi);
+                Array4<Real const> const& rho_new = ld.density.const_array(mfi);
+                Array4<Real>       const& rho_nph = density_nph[lev]->array(mfi);
+
+                amrex::ParallelFor(gbx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                {
+                    rho_nph(i,j,k) = 0.5 * (rho_old(i,j,k) + rho_new(i,j,k));
+                });
+            } // mfi
+        }
+    } // lev
+}
+
+void incflo::update_state_corrector (Vector<MultiFab*> const& density_nph,
+                                     Vector<MultiFab*> const& tra_forces)
+{
+    BL_PROFILE("incflo::update_state_corrector");
+
+    Real l_dt = m_dt;
+    bool l_constant_density = m_constant_density;
+    int l_ntrac = (m_advect_tracer) ? m_ntrac : 0;
+    DiffusionType l_diff_type = m_diff_type;
+    bool l_tensor_correction = use_tensor_correction;
+
+    GpuArray<Real,3> l_gravity{m_gravity[0],m_gravity[1],m_gravity[2]};
+    GpuArray<Real,3> l_gp0{m_gp0[0], m_gp0[1], m_gp0[2]};
+
+    const bool need_laps_o   = (l_ntrac > 0) && (l_diff_type != DiffusionType::Implicit);
+    const bool need_laps     = (l_ntrac > 0) && (l_diff_type == DiffusionType::Explicit);
+    const bool need_divtau_o = (l_diff_type != DiffusionType::Implicit);
+    const bool need_divtau   = (l_diff_type == DiffusionType::Explicit) || l_tensor_correction;
+
+    // The fused kernel writes density_nph unless it was needed before for the tracer forcing
+    bool l_write_nph = !l_constant_density && !m_advect_tracer;
+
+    // *************************************************************************************
+    // Half-time density for the tracer forcing terms
+    // *************************************************************************************
+    if (l_constant_density)
+    {
+        for (int lev = 0; lev <= finest_level; lev++)
+            MultiFab::Copy(*density_nph[lev], m_leveldata[lev]->density_o, 0, 0, 1, 0);
+    }
+    else if (m_advect_tracer)
+    {
+        for (int lev = 0; lev <= finest_level; lev++)
+        {
+            auto& ld = *m_leveldata[lev];
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+            for (MFIter mfi(ld.velocity,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+            {
+                Box const& bx = mfi.tilebox();
+                Array4<Real const> const& rho_o   = ld.density_o.const_array(mfi);
+                Array4<Real const> const& drdt_o  = ld.conv_density_o.const_array(mfi);
+                Array4<Real const> const& drdt    = ld.conv_density.const_array(mfi);
+                Array4<Real>       const& rho_nph = density_nph[lev]->array(mfi);
+
+                amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                {
+                    const Real rho_old = rho_o(i,j,k);
+                    Real rho_new = rho_old + l_dt * 0.5*(drdt(i,j,k)+drdt_o(i,j,k));
+                    rho_nph(i,j,k) = 0.5 * (rho_old + rho_new);
+                });
+            } // mfi
+        } // lev
+    }
+
+    if (m_advect_tracer)
+        compute_tra_forces(tra_forces, GetVecOfConstPtrs(density_nph));
+
+    // *************************************************************************************
+    // Update rho, (rho s) and u
+    // *************************************************************************************
+    for (int lev = 0; lev <= finest_level; lev++)
+    {
+        auto& ld = *m_leveldata[lev];
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(ld.velocity,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            Box const& bx = mfi.tilebox();
+            Array4<Real const> const& rho_o    = ld.density_o.const_array(mfi);
+            Array4<Real>       const& rho      = ld.density.array(mfi);
+            Array4<Real>       const& rho_h    = density_nph[lev]->array(mfi);
+            Array4<Real const> const& drdt_o   = ld.conv_density_o.const_array(mfi);
+            Array4<Real const> const& drdt     = ld.conv_density.const_array(mfi);
+
+            Array4<Real const> const& tra_o    = (l_ntrac > 0) ? ld.tracer_o.const_array(mfi)
+                                                               : Array4<Real const>{};
+            Array4<Real>       const& tra      = (l_ntrac > 0) ? ld.tracer.array(mfi)
+                                                               : Array4<Real>{};
+            Array4<Real const> const& dtdt_o   = (l_ntrac > 0) ? ld.conv_tracer_o.const_array(mfi)
+                                                               : Array4<Real const>{};
+            Array4<Real const> const& dtdt     = (l_ntrac > 0) ? ld.conv_tracer.const_array(mfi)
+                                                               : Array4<Real const>{};
+            Array4<Real const> const& tra_f    = (l_ntrac > 0) ? tra_forces[lev]->const_array(mfi)
+                                                               : Array4<Real const>{};
+            Array4<Real const> const& laps_o   = (need_laps_o) ? ld.laps_o.const_array(mfi)
+                                                               : Array4<Real const>{};
+            Array4<Real const> const& laps     = (need_laps) ? ld.laps.const_array(mfi)
+                                                             : Array4<Real const>{};
+
+            Array4<Real>       const& vel      = ld.velocity.array(mfi);
+            Array4<Real const> const& vel_o    = ld.velocity_o.const_array(mfi);
+            Array4<Real const> const& dvdt_o   = ld.conv_velocity_o.const_array(mfi);
+            Array4<Real const> const& dvdt     = ld.conv_velocity.const_array(mfi);
+            Array4<Real const> const& gradp    = ld.gp.const_array(mfi);
+            Array4<Real const> const& divtau_o = (need_divtau_o) ? ld.divtau_o.const_array(mfi)
+                                                                 : Array4<Real const>{};
+            Array4<Real const> const& divtau   = (need_divtau) ? ld.divtau.const_array(mfi)
+                                                               : Array4<Real const>{};
+
+            amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                const Real rho_old = rho_o(i,j,k);
+                Real rho_new = rho_old;
+                Real rho_nph = rho_old;
+                if (!l_constant_density)
+                {
+                    rho_new = rho_old + l_dt * 0.5*(drdt(i,j,k)+drdt_o(i,j,k));
+                    rho_nph = 0.5 * (rho_old + rho_new);
+                    rho(i,j,k) = rho_new;
+                    if (l_write_nph) rho_h(i,j,k) = rho_nph;
+                }
+
+                // (rho trac)^new = (rho trac)^old + dt * (
+                //                   div(rho trac u) + div (mu grad trac) + rho * f_t
+                for (int n = 0; n < l_ntrac; ++n)
+                {
+                    Real rhs = 0.5*(dtdt(i,j,k,n) + dtdt_o(i,j,k,n));
+                    if (l_diff_type == DiffusionType::Explicit) {
+                        rhs += 0.5*(laps_o(i,j,k,n) + laps(i,j,k,n));
+                    } else if (l_diff_type == DiffusionType::Crank_Nicolson) {
+                        rhs += 0.5*(laps_o(i,j,k,n));
+                    }
+                    rhs += tra_f(i,j,k,n);
+                    tra(i,j,k,n) = (rho_old*tra_o(i,j,k,n) + l_dt * rhs) / rho_new;
+                }
+
+                // With the tensor correction divtau is the difference of
+                // tensor and scalar divtau
+                Real rhoinv = 1.0/rho_nph;
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
+                {
+                    Real vel_f = -(gradp(i,j,k,idim)+l_gp0[idim])*rhoinv + l_gravity[idim];
+                    Real rhs = 0.5*(dvdt_o(i,j,k,idim) + dvdt(i,j,k,idim));
+                    if (l_diff_type == DiffusionType::Explicit) {
+                        rhs += 0.5*(divtau_o(i,j,k,idim) + divtau(i,j,k,idim));
+                    } else if (l_diff_type == DiffusionType::Crank_Nicolson) {
+                        rhs += 0.5*(divtau_o(i,j,k,idim));
+                    }
+                    rhs += vel_f;
+                    if (l_diff_type == DiffusionType::Implicit && l_tensor_correction) {
+                        rhs += divtau(i,j,k,idim);
+                    }
+                    vel(i,j,k,idim) = vel_o(i,j,k,idim) + l_dt * rhs;
+                }
+            });
+        } // mfi
+    } // lev
+}
@@ -14,11 +14,11 @@ using namespace amrex;
 //
 // phi is an auxiliary function related to the pressure p by the relation:
 //
-//     new p  = phi
+//     new p  = phi / scaling_factor
 //
 // except in the initial projection when
 //
-//     new p  = old p + phi     (nstep has its initial value -1)
+//     new p  = old p + phi / scaling_factor     (nstep has its initial value -1)
 //
 // Note: scaling_factor equals dt except when called during initial projection, when it is 1.0
 //
@@ -76,34 +76,38 @@ void incflo::ApplyNodalProjection (Vector<MultiFab const*> density,
         }
     }
 
-    Vector<amrex::MultiFab> sigma(finest_level+1);
+    Real strt_setup = ParallelDescriptor::second();
+
+    // The projector is built with sigma = 1/rho rather than scaling_factor/rho
+    // so that its coefficients do not depend on dt.  The resulting phi is
+    // therefore scaling_factor * p and is rescaled below.
     if (!m_constant_density)
     {
+        if (!nodal_projector) {
+            m_nodal_sigma.clear();
+            m_nodal_sigma.resize(finest_level+1);
+        }
         for (int lev = 0; lev <= finest_level; ++lev )
         {
-            sigma[lev].define(grids[lev], dmap[lev], 1, 0, MFInfo(), *m_factory[lev]);
+            if (!nodal_projector) {
+                m_nodal_sigma[lev].define(grids[lev], dmap[lev], 1, 0, MFInfo(), *m_factory[lev]);
+            }
 #ifdef _OPENMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
-            for (MFIter mfi(sigma[lev],TilingIfNotGPU()); mfi.isValid(); ++mfi)
+            for (MFIter mfi(m_nodal_sigma[lev],TilingIfNotGPU()); mfi.isValid(); ++mfi)
             {
                 Box const& bx = mfi.tilebox();
-                Array4<Real> const& sig = sigma[lev].array(mfi);
+                Array4<Real> const& sig = m_nodal_sigma[lev].array(mfi);
                 Array4<Real const> const& rho = density[lev]->const_array(mfi);
                 amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
                 {
-                    sig(i,j,k) = scaling_factor / rho(i,j,k);
+                    sig(i,j,k) = Real(1.0) / rho(i,j,k);
                 });
             }
         }
     }
 
-    // Perform projection
-    std::unique_ptr<Hydro::NodalProjector> nodal_projector;
-
-    auto bclo = get_projection_bc(Orientation::low);
-    auto bchi = get_projection_bc(Orientation::high);
-
     Vector<MultiFab*> vel;
     for (int lev = 0; lev <= finest_level; ++lev) {
 #ifdef AMREX_USE_EB
@@ -120,20 +124,36 @@ void incflo::ApplyNodalProjection (Vector<MultiFab const*> density,
         }
     }
 
-    LPInfo info;
-    info.setMaxCoarseningLevel(m_nodal_mg_max_coarsening_level);
-
-    if (m_constant_density)
+    // The projector holds pointers to the velocity and sigma MultiFabs, which
+    // persist until the grids change; it is reset by RemakeLevel,
+    // MakeNewLevelFromCoarse and ClearLevel.  Between calls we only have to
+    // update the coefficients and the inflow data.
+    if (!nodal_projector)
     {
-        Real constant_sigma = scaling_factor / m_ro_0;
-        nodal_projector.reset(new Hydro::NodalProjector(vel, constant_sigma,
-                                         Geom(0,finest_level), info));
-    } else
+        BL_PROFILE("incflo::ApplyNodalProjection::setup");
+
+        LPInfo info;
+        info.setMaxCoarseningLevel(m_nodal_mg_max_coarsening_level);
+
+        if (m_constant_density)
+        {
+            Real constant_sigma = Real(1.0) / m_ro_0;
+            nodal_projector.reset(new Hydro::NodalProjector(vel, constant_sigma,
+                                             Geom(0,finest_level), info));
+        } else
+        {
+            nodal_projector.reset(new Hydro::NodalProjector(vel, GetVecOfConstPtrs(m_nodal_sigma),
+                                             Geom(0,finest_level), info));
+        }
+        nodal_projector->setDomainBC(get_projection_bc(Orientation::low),
+                                     get_projection_bc(Orientation::high));
+    }
+    else if (!m_constant_density)
     {
-        nodal_projector.reset(new Hydro::NodalProjector(vel, GetVecOfConstPtrs(sigma),
-                                         Geom(0,finest_level), info));
+        for (int lev = 0; lev <= finest_level; ++lev) {
+            nodal_projector->getLinOp().setSigma(lev, m_nodal_sigma[lev]);
+        }
     }
-    nodal_projector->setDomainBC(bclo, bchi);
 
 #ifdef AMREX_USE_EB
     if (m_eb_flow.enabled) {
@@ -143,7 +163,101 @@ void incflo::ApplyNodalProjection (Vector<MultiFab const*> density,
     }
 #endif
 
-    nodal_projector->project(m_nodal_mg_rtol, m_nodal_mg_atol);
+    // In the incremental form phi is a pressure increment and we always start
+    // from zero. Otherwise phi = scaling_factor * p and we may start from
+    // the pressure we already have, rescaled for the current dt.
+    bool warm_start = !incremental && (m_nodal_warm_start != WarmStartType::None);
+    auto phi0 = nodal_projector->getPhi();
+    if (!warm_start)
+    {
+        // The projector is kept across calls and still holds the phi of its
+        // last solve: the solve must start from zero
+        for (int lev = 0; lev <= finest_level; ++lev) {
+            phi0[lev]->setVal(0.0);
+        }
+    }
+    else
+    {
+        // Extrapolate only at the first projection of a step; the corrector
+        // starts from the pressure just computed by the predictor.
+        bool first_of_step = (time != m_nodal_proj_time);
+        bool extrapolate = first_of_step && m_p_nd_prev_valid && m_prev_dt > 0.0 &&
+                           (m_nodal_warm_start == WarmStartType::Extrapolated);
+
+        // p_nd and m_p_nd_prev are the pressures at the end of the last two
+        // steps, i.e. approximately at t^{n-1/2} and t^{n-3/2}
+        Real ratio = 0.0;
+        if (extrapolate) {
+            ratio = (m_prev_prev_dt > 0.0) ? (m_dt + m_prev_dt) / (m_prev_dt + m_prev_prev_dt)
+                                           : m_dt / m_prev_dt;
+        }
+
+        // phi0 is filled in place and used as the initial guess
+        for (int lev = 0; lev <= finest_level; ++lev)
+        {
+            auto& ld = *m_leveldata[lev];
+            phi0[lev]->setVal(0.0);
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+            for (MFIter mfi(ld.p_nd,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+            {
+                Box const& nbx = mfi.tilebox();
+                Array4<Real> const& phi_lev = phi0[lev]->array(mfi);
+                Array4<Real const> const& p_lev = ld.p_nd.const_array(mfi);
+                if (extrapolate)
+                {
+                    Array4<Real const> const& p_prev = m_p_nd_prev[lev].const_array(mfi);
+                    amrex::ParallelFor(nbx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                    {
+                        phi_lev(i,j,k) = scaling_factor *
+                            (p_lev(i,j,k) + ratio * (p_lev(i,j,k) - p_prev(i,j,k)));
+                    });
+                } else {
+                    amrex::ParallelFor(nbx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                    {
+                        phi_lev(i,j,k) = scaling_factor * p_lev(i,j,k);
+                    });
+                }
+            }
+        }
+
+        if (first_of_step && m_nodal_warm_start == WarmStartType::Extrapolated)
+        {
+            if (m_p_nd_prev.empty()) {
+                m_p_nd_prev.resize(finest_level+1);
+                for (int lev = 0; lev <= finest_level; ++lev) {
+                    m_p_nd_prev[lev].define(m_leveldata[lev]->p_nd.boxArray(), dmap[lev], 1, 0,
+                                            MFInfo(), *m_factory[lev]);
+                }
+            }
+            for (int lev = 0; lev <= finest_level; ++lev) {
+                MultiFab::Copy(m_p_nd_prev[lev], m_leveldata[lev]->p_nd, 0, 0, 1, 0);
+            }
+            // The pressure from the initial projection is not a history we
+            // want to extrapolate from
+            m_p_nd_prev_valid = (time > 0.0);
+        }
+    }
+    if (!incremental) {
+        m_nodal_proj_time = time;
+    }
+
+    Real end_setup = ParallelDescriptor::second() - strt_setup;
+    Real strt_solve = ParallelDescriptor::second();
+
+    {
+        BL_PROFILE("incflo::ApplyNodalProjection::solve");
+        nodal_projector->project(m_nodal_mg_rtol, m_nodal_mg_atol);
+    }
+
+    Real end_solve = ParallelDescriptor::second() - strt_solve;
+
+    if (m_verbose > 0)
+    {
+        amrex::Print() << "Nodal projection: " << nodal_projector->getMLMG().getNumIters()
+                       << " MLMG iterations" << (warm_start ? " (warm start)" : "") << std::endl;
+    }
 
     // Define "vel" to be U^{n+1} rather than (U^{n+1}-U^n)
     if (proj_for_small_dt || incremental)
@@ -158,6 +272,9 @@ void incflo::ApplyNodalProjection (Vector<MultiFab const*> density,
     auto phi = nodal_projector->getPhi();
     auto gradphi = nodal_projector->getGradPhi();
 
+    // phi = scaling_factor * p since sigma = 1/rho
+    Real inv_scaling = Real(1.0) / scaling_factor;
+
     for(int lev = 0; lev <= finest_level; lev++)
     {
         auto& ld = *m_leveldata[lev];
@@ -175,21 +292,21 @@ void incflo::ApplyNodalProjection (Vector<MultiFab const*> density,
                 amrex::ParallelFor(tbx, AMREX_SPACEDIM,
                 [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
                 {
-                    gp_lev(i,j,k,n) += gp_proj(i,j,k,n);
+                    gp_lev(i,j,k,n) += gp_proj(i,j,k,n) * inv_scaling;
                 });
                 amrex::ParallelFor(nbx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
                 {
-                    p_lev (i,j,k) += p_proj(i,j,k);
+                    p_lev (i,j,k) += p_proj(i,j,k) * inv_scaling;
                 });
             } else {
                 amrex::ParallelFor(tbx, AMREX_SPACEDIM,
                 [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
                 {
-                    gp_lev(i,j,k,n) = gp_proj(i,j,k,n);
+                    gp_lev(i,j,k,n) = gp_proj(i,j,k,n) * inv_scaling;
                 });
                 amrex::ParallelFor(nbx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
                 {
-                    p_lev(i,j,k) = p_proj(i,j,k);
+                    p_lev(i,j,k) = p_proj(i,j,k) * inv_scaling;
                 });
             }
         }
@@ -205,6 +322,14 @@ void incflo::ApplyNodalProjection (Vector<MultiFab const*> density,
 #endif
     }
 
+    if (m_verbose > 1)
+    {
+        ParallelDescriptor::ReduceRealMax(end_setup, ParallelDescriptor::IOProcessorNumber());
+        ParallelDescriptor::ReduceRealMax(end_solve, ParallelDescriptor::IOProcessorNumber());
+        amrex::Print() << "Nodal projection: setup time " << end_setup
+                       << ", solve time " << end_solve << std::endl;
+    }
+
     if (m_verbose > 2)
     {
         if (proj_for_small_dt) {
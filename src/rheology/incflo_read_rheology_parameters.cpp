@@ -87,4 +87,82 @@ void incflo::ReadRheologyParameters()
      {
          amrex::Abort("Unknown fluid_model! Choose either newtonian, powerlaw, bingham, hb, smd");
      }
+
+     m_papa_reg_target = m_papa_reg;
+     std::string papa_reg_continuation_s = "none";
+     pp.query("papa_reg_continuation", papa_reg_continuation_s);
+     if(papa_reg_continuation_s == "none")
+     {
+         m_papa_reg_continuation = PapaRegContinuation::none;
+     }
+     else if(papa_reg_continuation_s == "schedule")
+     {
+         m_papa_reg_continuation = PapaRegContinuation::schedule;
+     }
+     else if(papa_reg_continuation_s == "iterations")
+     {
+         m_papa_reg_continuation = PapaRegContinuation::iterations;
+     }
+     else
+     {
+         amrex::Abort("Unknown papa_reg_continuation! Choose either none, schedule, iterations");
+     }
+
+     if(m_papa_reg_continuation != PapaRegContinuation::none)
+     {
+         AMREX_ALWAYS_ASSERT_WITH_MESSAGE(m_fluid_model == FluidModel::Bingham ||
+                                          m_fluid_model == FluidModel::HerschelBulkley,
+                 "papa_reg_continuation needs a Bingham or Herschel-Bulkley fluid");
+
+         pp.get("papa_reg_init", m_papa_reg_init);
+         AMREX_ALWAYS_ASSERT_WITH_MESSAGE(m_papa_reg_init > m_papa_reg_target,
+                 "papa_reg_init must be larger than papa_reg");
+
+         pp.query("papa_reg_factor", m_papa_reg_factor);
+         AMREX_ALWAYS_ASSERT(m_papa_reg_factor > 0.0 && m_papa_reg_factor < 1.0);
+
+         pp.query("papa_reg_interval", m_papa_reg_interval);
+         AMREX_ALWAYS_ASSERT(m_papa_reg_interval > 0);
+
+         pp.query("papa_reg_max_solver_iter", m_papa_reg_max_solver_iter);
+         AMREX_ALWAYS_ASSERT(m_papa_reg_max_solver_iter > 0);
+
+         m_papa_reg = m_papa_reg_init;
+
+         amrex::Print() << "Papanastasiou regularisation continuation (" << papa_reg_continuation_s
+                        << ") from papa_reg = " << m_papa_reg_init
+                        << " to " << m_papa_reg_target
+                        << " by factors of " << m_papa_reg_factor << std::endl;
+     }
+
+     std::string visc_nonlinear_s = "none";
+     pp.query("visc_nonlinear_iter", visc_nonlinear_s);
+     if(visc_nonlinear_s == "none")
+     {
+         m_visc_nonlinear = ViscNonlinearType::none;
+     }
+     else if(visc_nonlinear_s == "picard")
+     {
+         m_visc_nonlinear = ViscNonlinearType::picard;
+     }
+     else if(visc_nonlinear_s == "newton")
+     {
+         m_visc_nonlinear = ViscNonlinearType::newton;
+     }
+     else
+     {
+         amrex::Abort("Unknown visc_nonlinear_iter! Choose either none, picard, newton");
+     }
+
+     pp.query("visc_nonlinear_max_iter", m_visc_nonlinear_max_iter);
+     AMREX_ALWAYS_ASSERT(m_visc_nonlinear_max_iter > 0);
+     pp.query("visc_nonlinear_tol", m_visc_nonlinear_tol);
+     AMREX_ALWAYS_ASSERT(m_visc_nonlinear_tol >= 0.0);
+
+     if(m_visc_nonlinear != ViscNonlinearType::none && m_fluid_model != FluidModel::Newtonian)
+     {
+         amrex::Print() << "Iterating on the viscosity with " << visc_nonlinear_s
+                        << ", max_iter = " << m_visc_nonlinear_max_iter
+                        << ", tol = " << m_visc_nonlinear_tol << std::endl;
+     }
 }
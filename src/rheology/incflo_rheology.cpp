@@ -1,49 +1,46 @@
 #include <incflo.H>
 #include <incflo_derive_K.H>
+#include <incflo_rheology_K.H>
 
 using namespace amrex;
 
 namespace {
 
-AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
-amrex::Real expterm (amrex::Real nu) noexcept
-{
-    return (nu < 1.e-9) ? (1.0-0.5*nu+nu*nu*(1.0/6.0)-(nu*nu*nu)*(1./24.))
-                        : -std::expm1(-nu)/nu;
-}
-
-struct NonNewtonianViscosity
+template <typename Viscosity>
+void fill_viscosity (Box const& bx, Array4<Real> const& eta_arr, Array4<Real const> const& vel_arr,
+#ifdef AMREX_USE_EB
+                     EBCellFlagFab const& flag_fab,
+#endif
+                     AMREX_D_DECL(Real idx, Real idy, Real idz), Viscosity const& viscosity)
 {
-    incflo::FluidModel fluid_model;
-    amrex::Real mu, n_flow, tau_0, eta_0, papa_reg;
-
-    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
-    amrex::Real operator() (amrex::Real sr) const noexcept {
-        switch (fluid_model)
-        {
-        case incflo::FluidModel::powerlaw:
-        {
-            return mu * std::pow(sr,n_flow-1.0);
-        }
-        case incflo::FluidModel::Bingham:
-        {
-            return mu + tau_0 * expterm(sr/papa_reg) / papa_reg;
-        }
-        case incflo::FluidModel::HerschelBulkley:
+#ifdef AMREX_USE_EB
+    auto typ = flag_fab.getType(bx);
+    if (typ == FabType::covered)
+    {
+        amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
         {
-            return (mu*std::pow(sr,n_flow)+tau_0)*expterm(sr/papa_reg)/papa_reg;
-        }
-        case incflo::FluidModel::deSouzaMendesDutra:
+            eta_arr(i,j,k) = 0.0;
+        });
+    }
+    else if (typ == FabType::singlevalued)
+    {
+        auto const& flag_arr = flag_fab.const_array();
+        amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
         {
-            return (mu*std::pow(sr,n_flow)+tau_0)*expterm(sr*(eta_0/tau_0))*(eta_0/tau_0);
-        }
-        default:
+            Real sr = incflo_strainrate_eb(i,j,k,AMREX_D_DECL(idx,idy,idz),vel_arr,flag_arr(i,j,k));
+            eta_arr(i,j,k) = viscosity(sr);
+        });
+    }
+    else
+#endif
+    {
+        amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
         {
-            return mu;
-        }
-        };
+            Real sr = incflo_strainrate(i,j,k,AMREX_D_DECL(idx,idy,idz),vel_arr);
+            eta_arr(i,j,k) = viscosity(sr);
+        });
     }
-};
+}
 
 }
 
@@ -55,6 +52,11 @@ void incflo::compute_viscosity (Vector<MultiFab*> const& vel_eta,
     for (int lev = 0; lev <= finest_level; ++lev)
     {
         compute_viscosity_at_level(lev, vel_eta[lev], rho[lev], vel[lev], geom[lev], time, nghost);
+
+        // A Newtonian viscosity never changes, so its face values can be kept
+        if (m_fluid_model != FluidModel::Newtonian) {
+            invalidate_eta_faces(lev, *vel_eta[lev]);
+        }
     }
 }
 
@@ -71,13 +73,12 @@ void incflo::compute_viscosity_at_level (int lev,
     }
     else
     {
-        NonNewtonianViscosity non_newtonian_viscosity;
-        non_newtonian_viscosity.fluid_model = m_fluid_model;
-        non_newtonian_viscosity.mu = m_mu;
-        non_newtonian_viscosity.n_flow = m_n_0;
-        non_newtonian_viscosity.tau_0 = m_tau_0;
-        non_newtonian_viscosity.eta_0 = m_eta_0;
-        non_newtonian_viscosity.papa_reg = m_papa_reg;
+        rheology::ViscosityParams params;
+        params.mu = m_mu;
+        params.n_flow = m_n_0;
+        params.tau_0 = m_tau_0;
+        params.eta_0 = m_eta_0;
+        params.papa_reg = m_papa_reg;
 
 #ifdef AMREX_USE_EB
         auto const& fact = EBFactory(lev);
@@ -95,46 +96,226 @@ void incflo::compute_viscosity_at_level (int lev,
 #endif
         for (MFIter mfi(*vel_eta,TilingIfNotGPU()); mfi.isValid(); ++mfi)
         {
+                Real strt_cost = ParallelDescriptor::second();
+
                 Box const& bx = mfi.growntilebox(nghost);
                 Array4<Real> const& eta_arr = vel_eta->array(mfi);
                 Array4<Real const> const& vel_arr = vel->const_array(mfi);
+
+                // The fluid model and flow index are resolved here, so that the
+                // per-cell kernels are compiled for a single viscosity law
+                rheology::dispatch_viscosity(m_fluid_model, params,
+                    [&] (auto const& viscosity)
+                    {
+                        fill_viscosity(bx, eta_arr, vel_arr,
+#ifdef AMREX_USE_EB
+                                       flags[mfi],
+#endif
+                                       AMREX_D_DECL(idx,idy,idz), viscosity);
+                    });
+
+                if (collect_costs()) add_cost(lev, mfi, strt_cost);
+        }
+    }
+}
+
+void incflo::compute_tangent_viscosity (Vector<MultiFab*> const& eta_t,
+                                        Vector<MultiFab*> const& vel,
+                                        int nghost)
+{
+    BL_PROFILE("incflo::compute_tangent_viscosity");
+
+    rheology::ViscosityParams params;
+    params.mu = m_mu;
+    params.n_flow = m_n_0;
+    params.tau_0 = m_tau_0;
+    params.eta_0 = m_eta_0;
+    params.papa_reg = m_papa_reg;
+
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+#ifdef AMREX_USE_EB
+        auto const& fact = EBFactory(lev);
+        auto const& flags = fact.getMultiEBCellFlagFab();
+#endif
+
+        Real idx = 1.0 / geom[lev].CellSize(0);
+        Real idy = 1.0 / geom[lev].CellSize(1);
+#if (AMREX_SPACEDIM == 3)
+        Real idz = 1.0 / geom[lev].CellSize(2);
+#endif
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(*eta_t[lev],TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            Box const& bx = mfi.growntilebox(nghost);
+            Array4<Real> const& eta_arr = eta_t[lev]->array(mfi);
+            Array4<Real const> const& vel_arr = vel[lev]->const_array(mfi);
+
+            rheology::dispatch_viscosity(m_fluid_model, params,
+                [&] (auto const& viscosity)
+                {
+                    using V = std::decay_t<decltype(viscosity)>;
+                    fill_viscosity(bx, eta_arr, vel_arr,
+#ifdef AMREX_USE_EB
+                                   flags[mfi],
+#endif
+                                   AMREX_D_DECL(idx,idy,idz),
+                                   rheology::TangentViscosity<V>(viscosity));
+                });
+        }
+
+        invalidate_eta_faces(lev, *eta_t[lev]);
+    }
+}
+
+// Reduce the Papanastasiou regularisation parameter towards its target, at the
+// start of a step. The schedule is a function of the step number only, so that
+// it is recovered on restart; the iteration-driven one restarts from papa_reg_init.
+void incflo::UpdateRegularisation ()
+{
+    if (m_papa_reg_continuation == PapaRegContinuation::none ||
+        m_papa_reg <= m_papa_reg_target) return;
+
+    Real papa_reg = m_papa_reg;
+    if (m_papa_reg_continuation == PapaRegContinuation::schedule)
+    {
+        papa_reg = m_papa_reg_init * std::pow(m_papa_reg_factor, m_nstep / m_papa_reg_interval);
+    }
+    else
+    {
+        // Only go on once the current regularisation no longer slows the solver down
+        int iters = lastVelocitySolveIters();
+        if (iters > 0 && iters <= m_papa_reg_max_solver_iter) {
+            papa_reg = m_papa_reg * m_papa_reg_factor;
+        }
+    }
+    papa_reg = amrex::max(papa_reg, m_papa_reg_target);
+
+    if (papa_reg != m_papa_reg)
+    {
+        m_papa_reg = papa_reg;
+        if (m_verbose > 0) {
+            amrex::Print() << "Papanastasiou regularisation parameter set to " << m_papa_reg
+                           << " (target " << m_papa_reg_target << ")" << std::endl;
+        }
+    }
+}
+
+void incflo::compute_tracer_diff_coeff (Vector<MultiFab*> const& tra_eta,
+                                        Vector<MultiFab*> const& rho,
+                                        Vector<MultiFab*> const& vel,
+                                        Vector<MultiFab*> const& tracer,
+                                        int nghost)
+{
+    BL_PROFILE("incflo::compute_tracer_diff_coeff");
+
+    for (int lev = 0; lev < static_cast<int>(tra_eta.size()); ++lev)
+    {
+        MultiFab& eta = *tra_eta[lev];
+
+        if (m_tracer_diff_model == TracerDiffusivityModel::constant)
+        {
+            // The constants only need to be written once per workspace, and the
+            // face values built by get_eta_faces stay valid
+            auto& ws = get_workspace(lev);
+            bool cached = (&eta == &ws.tra_eta);
+            if (cached && ws.tra_eta_constant) continue;
+
+            for (int n = 0; n < m_ntrac; ++n) {
+                eta.setVal(m_mu_s[n], n, 1, nghost);
+            }
+
+            if (cached) ws.tra_eta_constant = true;
+            continue;
+        }
+
+        const int ntrac = m_ntrac;
+        Real const* mu_s = m_mu_s_d.data();
+
+#ifdef AMREX_USE_EB
+        auto const& fact = EBFactory(lev);
+        auto const& flags = fact.getMultiEBCellFlagFab();
+#endif
+
+        Real idx = 1.0 / geom[lev].CellSize(0);
+        Real idy = 1.0 / geom[lev].CellSize(1);
+#if (AMREX_SPACEDIM == 3)
+        Real idz = 1.0 / geom[lev].CellSize(2);
+#endif
+        // Filter width of the eddy diffusivity
+        Real delta = AMREX_D_TERM(geom[lev].CellSize(0), *geom[lev].CellSize(1), *geom[lev].CellSize(2));
+        delta = std::pow(delta, 1.0/AMREX_SPACEDIM);
+        Real eddy_coef = (m_tracer_diff_cs*delta)*(m_tracer_diff_cs*delta)/m_tracer_diff_sct;
+
+        Real alpha = m_tracer_diff_alpha;
+        Real temp_ref = m_tracer_diff_temp_ref;
+        int temp_comp = m_tracer_diff_temp_comp;
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(eta,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            Box const& bx = mfi.growntilebox(nghost);
+            Array4<Real> const& eta_arr = eta.array(mfi);
+
+            if (m_tracer_diff_model == TracerDiffusivityModel::temperature)
+            {
+                Array4<Real const> const& tra_arr = tracer[lev]->const_array(mfi);
+                amrex::ParallelFor(bx, ntrac,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+                {
+                    Real f = 1.0 + alpha*(tra_arr(i,j,k,temp_comp)-temp_ref);
+                    eta_arr(i,j,k,n) = mu_s[n] * amrex::max(f, Real(0.0));
+                });
+            }
+            else
+            {
+                Array4<Real const> const& vel_arr = vel[lev]->const_array(mfi);
+                Array4<Real const> const& rho_arr = rho[lev]->const_array(mfi);
 #ifdef AMREX_USE_EB
                 auto const& flag_fab = flags[mfi];
                 auto typ = flag_fab.getType(bx);
                 if (typ == FabType::covered)
                 {
-                    amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                    amrex::ParallelFor(bx, ntrac,
+                    [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
                     {
-                        eta_arr(i,j,k) = 0.0;
+                        eta_arr(i,j,k,n) = 0.0;
                     });
                 }
                 else if (typ == FabType::singlevalued)
                 {
                     auto const& flag_arr = flag_fab.const_array();
-                    amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                    amrex::ParallelFor(bx,
+                    [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
                     {
                         Real sr = incflo_strainrate_eb(i,j,k,AMREX_D_DECL(idx,idy,idz),vel_arr,flag_arr(i,j,k));
-                        eta_arr(i,j,k) = non_newtonian_viscosity(sr);
+                        Real eddy = eddy_coef * rho_arr(i,j,k) * sr;
+                        for (int n = 0; n < ntrac; ++n) {
+                            eta_arr(i,j,k,n) = mu_s[n] + eddy;
+                        }
                     });
                 }
                 else
 #endif
                 {
-                    amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                    amrex::ParallelFor(bx,
+                    [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
                     {
                         Real sr = incflo_strainrate(i,j,k,AMREX_D_DECL(idx,idy,idz),vel_arr);
-                        eta_arr(i,j,k) = non_newtonian_viscosity(sr);
+                        Real eddy = eddy_coef * rho_arr(i,j,k) * sr;
+                        for (int n = 0; n < ntrac; ++n) {
+                            eta_arr(i,j,k,n) = mu_s[n] + eddy;
+                        }
                     });
                 }
+            }
         }
-    }
-}
 
-void incflo::compute_tracer_diff_coeff (Vector<MultiFab*> const& tra_eta, int nghost)
-{
-    for (auto mf : tra_eta) {
-        for (int n = 0; n < m_ntrac; ++n) {
-            mf->setVal(m_mu_s[n], n, 1, nghost);
-        }
+        invalidate_eta_faces(lev, eta);
     }
 }
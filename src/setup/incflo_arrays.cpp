@@ -7,15 +7,13 @@ incflo::LevelData::LevelData (amrex::BoxArray const& ba,
                               amrex::FabFactory<FArrayBox> const& fact,
                               int ntrac, int ng_state,
                               std::string advection_type, bool implicit_diffusion,
-                              bool use_tensor_correction, bool advect_tracer)
+                              bool use_tensor_correction, bool advect_tracer,
+                              bool eb_flow)
     : velocity  (ba, dm, AMREX_SPACEDIM, ng_state, MFInfo(), fact),
       velocity_o(ba, dm, AMREX_SPACEDIM, ng_state, MFInfo(), fact),
-      velocity_eb(ba, dm, AMREX_SPACEDIM, ng_state, MFInfo(), fact),
       density   (ba, dm, 1             , ng_state, MFInfo(), fact),
-      density_eb(ba, dm, 1             , ng_state, MFInfo(), fact),
       density_o (ba, dm, 1             , ng_state, MFInfo(), fact),
       tracer    (ba, dm, ntrac         , ng_state, MFInfo(), fact),
-      tracer_eb (ba, dm, ntrac         , ng_state, MFInfo(), fact),
       tracer_o  (ba, dm, ntrac         , ng_state, MFInfo(), fact),
       gp        (ba, dm, AMREX_SPACEDIM, 0       , MFInfo(), fact),
       mac_phi   (ba, dm, 1             , 1       , MFInfo(), fact),
@@ -26,6 +24,12 @@ incflo::LevelData::LevelData (amrex::BoxArray const& ba,
       conv_density_o (ba, dm, 1             , 0, MFInfo(), fact),
       conv_tracer_o  (ba, dm, ntrac         , 0, MFInfo(), fact)
 {
+    if (eb_flow) {
+        velocity_eb.define(ba, dm, AMREX_SPACEDIM, ng_state, MFInfo(), fact);
+        density_eb.define (ba, dm, 1             , ng_state, MFInfo(), fact);
+        tracer_eb.define  (ba, dm, ntrac         , ng_state, MFInfo(), fact);
+    }
+
     if (advection_type != "MOL") {
         divtau_o.define(ba, dm, AMREX_SPACEDIM, 0, MFInfo(), fact);
         if (advect_tracer) {
@@ -58,6 +62,114 @@ void incflo::ResizeArrays ()
     m_t_old.resize(max_level + 1);
 
     m_leveldata.resize(max_level+1);
+    m_workspace.resize(max_level+1);
+    m_eta_faces.resize(max_level+1);
 
     m_factory.resize(max_level+1);
+    m_costs.resize(max_level+1);
+#ifdef AMREX_USE_EB
+    m_factory_cache.resize(max_level+1);
+#endif
+}
+
+incflo::Workspace::Workspace (amrex::BoxArray const& ba,
+                              amrex::DistributionMapping const& dm,
+                              amrex::FabFactory<FArrayBox> const& fact,
+                              int ntrac, int ng_state, int ng_mac, int ng_force,
+                              bool constant_density, bool advect_tracer, bool need_vel_eta)
+    : AMREX_D_DECL(u_mac(amrex::convert(ba,IntVect::TheDimensionVector(0)), dm, 1, ng_mac, MFInfo(), fact),
+                   v_mac(amrex::convert(ba,IntVect::TheDimensionVector(1)), dm, 1, ng_mac, MFInfo(), fact),
+                   w_mac(amrex::convert(ba,IntVect::TheDimensionVector(2)), dm, 1, ng_mac, MFInfo(), fact)),
+      density_nph(ba, dm, 1             , 1       , MFInfo(), fact),
+      vel_forces (ba, dm, AMREX_SPACEDIM, ng_force, MFInfo(), fact),
+      divu       (ba, dm, 1             , 4       , MFInfo(), fact)
+{
+    if (need_vel_eta) {
+        vel_eta.define(ba, dm, 1, 1, MFInfo(), fact);
+    }
+    if (advect_tracer) {
+        tra_forces.define(ba, dm, ntrac, ng_force, MFInfo(), fact);
+        tra_eta.define   (ba, dm, ntrac, 1       , MFInfo(), fact);
+        if (ntrac > 0) {
+            rhotrac.define(ba, dm, ntrac, ng_state, MFInfo(), fact);
+        }
+    }
+
+    int n_flux_comp = AMREX_SPACEDIM;
+    if (!constant_density) n_flux_comp += 1;
+    if ( advect_tracer)    n_flux_comp += ntrac;
+
+    AMREX_D_TERM(face_x.define(u_mac.boxArray(), dm, n_flux_comp, 0, MFInfo(), fact);,
+                 face_y.define(v_mac.boxArray(), dm, n_flux_comp, 0, MFInfo(), fact);,
+                 face_z.define(w_mac.boxArray(), dm, n_flux_comp, 0, MFInfo(), fact););
+    AMREX_D_TERM(flux_x.define(u_mac.boxArray(), dm, n_flux_comp, 0, MFInfo(), fact);,
+                 flux_y.define(v_mac.boxArray(), dm, n_flux_comp, 0, MFInfo(), fact);,
+                 flux_z.define(w_mac.boxArray(), dm, n_flux_comp, 0, MFInfo(), fact););
+
+#ifdef AMREX_USE_EB
+    dvdt_tmp.define(ba, dm, AMREX_SPACEDIM, 3, MFInfo(), fact);
+    drdt_tmp.define(ba, dm, 1             , 3, MFInfo(), fact);
+    dtdt_tmp.define(ba, dm, ntrac         , 3, MFInfo(), fact);
+#endif
+}
+
+Long incflo::Workspace::nBytes () const
+{
+    Long r = 0;
+    for (MultiFab const* mf : {AMREX_D_DECL(&u_mac, &v_mac, &w_mac),
+                               &density_nph, &vel_forces, &tra_forces, &vel_eta, &tra_eta, &vel_eta_t,
+                               AMREX_D_DECL(&face_x, &face_y, &face_z),
+                               AMREX_D_DECL(&flux_x, &flux_y, &flux_z),
+                               &divu, &rhotrac
+#ifdef AMREX_USE_EB
+                               , &dvdt_tmp, &drdt_tmp, &dtdt_tmp
+#endif
+                              })
+    {
+        if (mf->ok()) {
+            for (MFIter mfi(*mf); mfi.isValid(); ++mfi) {
+                r += (*mf)[mfi].nBytes();
+            }
+        }
+    }
+    return r;
+}
+
+incflo::Workspace& incflo::get_workspace (int lev)
+{
+    if (!m_workspace[lev]) {
+        m_workspace[lev].reset(new Workspace(grids[lev], dmap[lev], *m_factory[lev],
+                                             m_ntrac, nghost_state(), nghost_mac(), nghost_force(),
+                                             m_constant_density, m_advect_tracer,
+                                             needVelocityEta()));
+    }
+    return *m_workspace[lev];
+}
+
+Vector<MultiFab*> incflo::get_workspace (MultiFab Workspace::* mf)
+{
+    Vector<MultiFab*> r;
+    if ((get_workspace(0).*mf).ok()) {
+        r.reserve(finest_level+1);
+        for (int lev = 0; lev <= finest_level; ++lev) {
+            r.push_back(&(get_workspace(lev).*mf));
+        }
+    }
+    return r;
+}
+
+void incflo::PrintWorkspaceStats ()
+{
+    Long bytes = 0;
+    for (auto const& ws : m_workspace) {
+        if (ws) bytes += ws->nBytes();
+    }
+    Long hwm = amrex::TotalBytesAllocatedInFabsHWM();
+
+    ParallelDescriptor::ReduceLongMax(bytes, ParallelDescriptor::IOProcessorNumber());
+    ParallelDescriptor::ReduceLongMax(hwm  , ParallelDescriptor::IOProcessorNumber());
+
+    amrex::Print() << "Workspace memory: " << static_cast<double>(bytes)/(1024.*1024.)
+                   << " MB, FAB high-water mark: " << static_cast<double>(hwm)/(1024.*1024.)
+                   << " MB (max over ranks)" << std::endl;
 }
@@ -50,6 +50,29 @@ void incflo::ReadParameters ()
             amrex::Abort("We require m_init_shrink <= 1.0");
         }
 
+        pp.query("dt_max_growth", m_dt_max_growth);
+        pp.query("dt_max_shrink", m_dt_max_shrink);
+        if (m_dt_max_growth < 1.0 || m_dt_max_shrink <= 0.0 || m_dt_max_shrink > 1.0) {
+            amrex::Abort("We require dt_max_growth >= 1.0 and 0.0 < dt_max_shrink <= 1.0");
+        }
+
+        std::string dt_controller = "none";
+        pp.query("dt_controller", dt_controller);
+        if (dt_controller == "none") {
+            m_dt_controller = DtController::none;
+        } else if (dt_controller == "pi") {
+            m_dt_controller = DtController::pi;
+            pp.query("dt_controller_ki", m_dt_controller_ki);
+            pp.query("dt_controller_kp", m_dt_controller_kp);
+            pp.query("dt_controller_safety", m_dt_controller_safety);
+            pp.query("dt_controller_target_iters", m_dt_controller_target_iters);
+            if (m_dt_controller_safety <= 0.0 || m_dt_controller_safety > 1.0) {
+                amrex::Abort("We require 0.0 < dt_controller_safety <= 1.0");
+            }
+        } else {
+            amrex::Abort("dt_controller must be none or pi");
+        }
+
         // Physics
     pp.queryarr("delp", m_delp, 0, AMREX_SPACEDIM);
     pp.queryarr("gravity", m_gravity, 0, AMREX_SPACEDIM);
@@ -75,6 +98,12 @@ void incflo::ReadParameters ()
             m_redistribution_type != "StateRedist")
             amrex::Abort("redistribution type must be NoRedist, FluxRedist, or StateRedist");
 
+        // Number of EB factories kept per level for reuse after regridding
+        pp.query("eb_factory_cache_size", m_factory_cache_size);
+
+        // Relative cost of a cut cell used to distribute new grids
+        pp.query("eb_cut_cell_weight", m_eb_cut_cell_weight);
+
     if (m_advection_type == "Godunov" && m_godunov_ppm) amrex::Abort("Cant use PPM with EBGodunov");
 #endif
 
@@ -96,9 +125,19 @@ void incflo::ReadParameters ()
             amrex::Abort("We currently require diffusion_type = 0 for explicit, 1 for Crank-Nicolson or 2 for implicit");
         }
 
+        // There is no velocity solve to count iterations of with explicit diffusion
+        if (m_papa_reg_continuation == PapaRegContinuation::iterations &&
+            m_diff_type == DiffusionType::Explicit) {
+            amrex::Abort("papa_reg_continuation = iterations needs diffusion_type = 1 or 2; "
+                         "use schedule with explicit diffusion");
+        }
+
         // Default is true; should we use tensor solve instead of separate solves for each component?
         pp.query("use_tensor_solve",use_tensor_solve);
         pp.query("use_tensor_correction",use_tensor_correction);
+        pp.query("constant_coeff_diffusion", m_constant_coeff_diffusion);
+        pp.query("fused_divtau", m_fused_divtau);
+        pp.query("fused_state_update", m_fused_state_update);
 
         if (use_tensor_solve && use_tensor_correction) {
             amrex::Abort("We cannot have both use_tensor_solve and use_tensor_correction be true");
@@ -141,11 +180,45 @@ void incflo::ReadParameters ()
         // Scalar diffusion coefficients
         m_mu_s.resize(m_ntrac, 0.0);
         pp.queryarr("mu_s", m_mu_s, 0, m_ntrac );
+        m_mu_s_d.resize(m_ntrac);
+        Gpu::copy(Gpu::hostToDevice, m_mu_s.begin(), m_mu_s.end(), m_mu_s_d.begin());
 
         amrex::Print() << "Scalar diffusion coefficients " << std::endl;
         for (int i = 0; i < m_ntrac; i++) {
             amrex::Print() << "Tracer diffusion coeff: " << i << ":" << m_mu_s[i] << std::endl;
         }
+
+        std::string tracer_diff_model_s = "constant";
+        pp.query("tracer_diffusivity_model", tracer_diff_model_s);
+        if (tracer_diff_model_s == "constant") {
+            m_tracer_diff_model = TracerDiffusivityModel::constant;
+        } else if (tracer_diff_model_s == "temperature") {
+            m_tracer_diff_model = TracerDiffusivityModel::temperature;
+            pp.query("tracer_diffusivity_temp_comp", m_tracer_diff_temp_comp);
+            AMREX_ALWAYS_ASSERT(m_tracer_diff_temp_comp >= 0 && m_tracer_diff_temp_comp < m_ntrac);
+            pp.query("tracer_diffusivity_alpha", m_tracer_diff_alpha);
+            pp.query("tracer_diffusivity_temp_ref", m_tracer_diff_temp_ref);
+        } else if (tracer_diff_model_s == "eddy") {
+            m_tracer_diff_model = TracerDiffusivityModel::eddy;
+            pp.query("tracer_diffusivity_cs", m_tracer_diff_cs);
+            pp.query("tracer_diffusivity_sct", m_tracer_diff_sct);
+            AMREX_ALWAYS_ASSERT(m_tracer_diff_cs >= 0.0 && m_tracer_diff_sct > 0.0);
+        } else {
+            amrex::Abort("tracer_diffusivity_model must be constant, temperature or eddy");
+        }
+
+        // Load balancing
+        pp.query("load_balance_type", m_load_balance_type);
+        pp.query("knapsack_weight_type", m_knapsack_weight_type);
+        pp.query("knapsack_nmax", m_knapsack_nmax);
+        pp.query("load_balance_int", m_load_balance_int);
+
+        if (m_load_balance_type != "KnapSack" && m_load_balance_type != "SFC") {
+            amrex::Abort("load_balance_type must be KnapSack or SFC");
+        }
+        if (m_knapsack_weight_type != "RunTimeCosts") {
+            amrex::Abort("knapsack_weight_type must be RunTimeCosts");
+        }
     } // end prefix incflo
 
     { // Prefix mac
@@ -157,6 +230,7 @@ void incflo::ReadParameters ()
         pp_mac.query( "mg_maxiter"             , m_mac_mg_maxiter );
         pp_mac.query( "mg_bottom_maxiter"      , m_mac_mg_bottom_maxiter );
         pp_mac.query( "mg_max_coarsening_level", m_mac_mg_max_coarsening_level );
+        pp_mac.query( "warm_start"             , m_mac_warm_start );
     } // end prefix mac
 
     { // Prefix nodal
@@ -164,6 +238,18 @@ void incflo::ReadParameters ()
         pp_nodal.query( "mg_max_coarsening_level", m_nodal_mg_max_coarsening_level );
         pp_nodal.query( "mg_rtol"                , m_nodal_mg_rtol );
         pp_nodal.query( "mg_atol"                , m_nodal_mg_atol );
+
+        std::string warm_start = "none";
+        pp_nodal.query( "warm_start"             , warm_start );
+        if (warm_start == "none") {
+            m_nodal_warm_start = WarmStartType::None;
+        } else if (warm_start == "previous") {
+            m_nodal_warm_start = WarmStartType::Previous;
+        } else if (warm_start == "extrapolate") {
+            m_nodal_warm_start = WarmStartType::Extrapolated;
+        } else {
+            amrex::Abort("nodal_proj.warm_start must be none, previous or extrapolate");
+        }
     } // end prefix nodal
 
 #ifdef AMREX_USE_EB
@@ -311,11 +397,15 @@ void incflo::InitialIterations ()
         if (m_verbose) amrex::Print() << "\n In initial_iterations: iter = " << iter << "\n";
 
      ApplyPredictor(true);
-
-        copy_from_old_to_new_velocity();
-        copy_from_old_to_new_density();
-        copy_from_old_to_new_tracer();
     }
+
+    // Each iteration starts again from the old state, so only the last one needs to
+    // be undone: the old state becomes the new one, and whatever is left in the
+    // old MultiFabs is replaced at the start of the first step. The constant
+    // density and unadvected tracers were not changed.
+    swap_new_and_old_velocity();
+    if (!m_constant_density) swap_new_and_old_density();
+    if (m_advect_tracer) swap_new_and_old_tracer();
 }
 
 // Project velocity field to make sure initial velocity is divergence-free
@@ -195,7 +195,7 @@ void incflo::ReadCheckpointFile()
         GotoNextLine(is);
 
         // Create distribution mapping
-        DistributionMapping dm{ba, ParallelDescriptor::NProcs()};
+        DistributionMapping dm = MakeDistributionMap(lev, ba);
 
         MakeNewLevelFromScratch(lev, m_cur_time, ba, dm);
     }